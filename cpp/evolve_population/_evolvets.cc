@@ -49,6 +49,8 @@ init_evolve_with_tree_sequences(py::module &m)
                            reset_treeseqs_to_alive_nodes_after_simplification)
         .def_readwrite("preserve_first_generation",
                        &evolve_with_tree_sequences_options::preserve_first_generation)
+        .def_readwrite("fold_selected_fixations",
+                       &evolve_with_tree_sequences_options::fold_selected_fixations)
         .def_readwrite("allow_residual_selfing",
                        &evolve_with_tree_sequences_options::allow_residual_selfing);
 
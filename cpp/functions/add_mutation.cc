@@ -89,8 +89,8 @@ namespace
 
     bool
     node_has_valid_time(const std::vector<fwdpp::ts::node>& node_table,
-                        const std::int32_t mutation_node,
-                        const std::int32_t mutation_node_parent)
+                        const fwdpp::ts::table_index_t mutation_node,
+                        const fwdpp::ts::table_index_t mutation_node_parent)
     {
         if (mutation_node_parent == fwdpp::ts::NULL_INDEX)
             {
@@ -219,8 +219,8 @@ namespace
     std::int64_t
     generate_mutation_time(const fwdpy11::GSLrng_t& rng,
                            const std::vector<fwdpp::ts::node>& node_table,
-                           const std::int32_t mutation_node,
-                           const std::int32_t mutation_node_parent)
+                           const fwdpp::ts::table_index_t mutation_node,
+                           const fwdpp::ts::table_index_t mutation_node_parent)
     {
         auto mutation_node_time = node_table[mutation_node].time;
         // Check for easy case where we can assign mutation time == node time
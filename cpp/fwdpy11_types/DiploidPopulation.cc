@@ -113,7 +113,7 @@ init_DiploidPopulation(py::module& m)
         .def("_set_mutations",
              [](fwdpy11::DiploidPopulation& self,
                 const std::vector<fwdpy11::Mutation>& mutations,
-                const std::vector<std::int32_t>& mutation_nodes,
+                const std::vector<fwdpp::ts::table_index_t>& mutation_nodes,
                 const std::vector<fwdpy11::mutation_origin_time>& origin_times) {
                  set_mutations(mutations, mutation_nodes, origin_times, self);
              })
@@ -159,7 +159,8 @@ init_DiploidPopulation(py::module& m)
                  auto dump = py::module::import("pickle").attr("dump");
                  dump(py::make_tuple(self.diploids.size(), self.haploid_genomes.size(),
                                      self.mutations.size(), self.fixations.size(),
-                                     self.generation, self.tables->genome_length()),
+                                     self.generation, self.tables->genome_length(),
+                                     self.num_folded_fixations),
                       f);
                  for (auto& d : self.diploids)
                      {
@@ -228,6 +229,11 @@ init_DiploidPopulation(py::module& m)
                 auto ngams = popdata[1].cast<std::size_t>();
                 auto nmuts = popdata[2].cast<std::size_t>();
                 auto nfixations = popdata[3].cast<std::size_t>();
+                // Files written before 0.25.0 have no folded fixations
+                if (popdata.size() > 6)
+                    {
+                        rv.num_folded_fixations = popdata[6].cast<std::uint64_t>();
+                    }
                 rv.diploids.clear();
                 rv.haploid_genomes.clear();
                 rv.mutations.clear();
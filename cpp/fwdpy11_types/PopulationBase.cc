@@ -126,6 +126,8 @@ init_PopulationBase(py::module& m)
         .def_readonly("_haploid_genomes", &fwdpy11::Population::haploid_genomes)
         .def_readonly("_fixations", &fwdpy11::Population::fixations)
         .def_readonly("_fixation_times", &fwdpy11::Population::fixation_times)
+        .def_readonly("_num_folded_fixations",
+                      &fwdpy11::Population::num_folded_fixations)
         .def("_find_mutation_by_key",
              [](const fwdpy11::Population& pop,
                 const std::tuple<double, double, fwdpp::uint_t>& key,
@@ -16,6 +16,20 @@ struct GaussianNoise : public fwdpy11::GeneticValueNoise
         return mean + gsl_ran_gaussian_ziggurat(data.rng.get().get(), sd);
     }
 
+    bool
+    noise_batch(const fwdpy11::GSLrng_t& rng, std::size_t n, double* e) const override
+    {
+        for (std::size_t i = 0; i < n; ++i)
+            {
+                e[i] = gsl_ran_gaussian_ziggurat(rng.get(), sd);
+            }
+        for (std::size_t i = 0; i < n; ++i)
+            {
+                e[i] += mean;
+            }
+        return true;
+    }
+
     void
     update(const fwdpy11::DiploidPopulation& /*pop*/) override
     {
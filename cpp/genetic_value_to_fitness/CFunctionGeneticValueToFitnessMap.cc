@@ -0,0 +1,38 @@
+//
+// Copyright (C) 2026 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+
+#include <cstdint>
+#include <fwdpy11/genetic_value_to_fitness/CFunctionGeneticValueToFitnessMap.hpp>
+#include <pybind11/pybind11.h>
+
+namespace py = pybind11;
+
+void
+init_CFunctionGeneticValueToFitnessMap(py::module& m)
+{
+    py::class_<fwdpy11::CFunctionGeneticValueToFitnessMap, fwdpy11::GeneticValueIsTrait>(
+        m, "_ll_CFunctionGeneticValueToFitnessMap")
+        .def(py::init([](std::uintptr_t address, std::uintptr_t user_data,
+                         std::size_t ndim) {
+                 return fwdpy11::CFunctionGeneticValueToFitnessMap(
+                     reinterpret_cast<fwdpy11_gvalue_to_fitness_function>(address),
+                     reinterpret_cast<void*>(user_data), ndim);
+             }),
+             py::arg("address"), py::arg("user_data"), py::arg("ndim"));
+}
@@ -15,6 +15,7 @@ void init_GaussianStabilizingSelection(py::module&);
 
 // Multivariate classes
 void init_MultivariateGSSmo(py::module&);
+void init_CFunctionGeneticValueToFitnessMap(py::module&);
 
 void
 initialize_genetic_value_to_fitness(py::module& m)
@@ -29,4 +30,5 @@ initialize_genetic_value_to_fitness(py::module& m)
     init_GaussianStabilizingSelection(m);
 
     init_MultivariateGSSmo(m);
+    init_CFunctionGeneticValueToFitnessMap(m);
 }
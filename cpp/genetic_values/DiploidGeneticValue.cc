@@ -1,3 +1,5 @@
+#include <stdexcept>
+#include <vector>
 #include <fwdpy11/genetic_values/DiploidGeneticValue.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
@@ -39,6 +41,34 @@ init_DiploidGeneticValue(py::module& m)
         //    "noise",
         //    [](const fwdpy11::DiploidGeneticValue& o) { return o.noise_fxn->clone(); },
         //    "Access the random noise funcion")
+        .def_property_readonly(
+            "fixation_baseline",
+            [](const fwdpy11::DiploidGeneticValue& self) {
+                return self.fixation_baseline;
+            },
+            R"delim(
+        The contribution of selected fixations that have been
+        removed from genomes during a simulation, one value per deme
+        (or per trait, for multivariate effects).
+        Empty if the type does not support folding fixations.
+
+        .. versionadded:: 0.25.0
+        )delim")
+        .def_readonly("_num_folded_fixations",
+                      &fwdpy11::DiploidGeneticValue::num_folded_fixations)
+        .def(
+            "_set_fixation_baseline",
+            [](fwdpy11::DiploidGeneticValue& self, std::vector<double> baseline,
+               std::uint64_t num_folded_fixations) {
+                if (baseline.size() != self.fixation_baseline.size())
+                    {
+                        throw std::invalid_argument(
+                            "fixation baseline has the wrong length");
+                    }
+                self.fixation_baseline.swap(baseline);
+                self.num_folded_fixations = num_folded_fixations;
+            },
+            py::arg("baseline"), py::arg("num_folded_fixations"))
         .def_property_readonly(
             "maps_to_fitness",
             [](const fwdpy11::DiploidGeneticValue& self) {
@@ -92,6 +92,33 @@ namespace
             return gvalues[0];
         }
 
+        bool
+        calculate_gvalues(const fwdpy11::GSLrng_t& /*rng*/,
+                          const fwdpy11::DiploidPopulation& pop,
+                          const std::vector<fwdpy11::DiploidMetadata>& offspring_metadata,
+                          const std::vector<std::size_t>& individuals,
+                          std::vector<double>& batch_gvalues) override
+        // Same calculation as calculate_gvalue without the
+        // std::function dispatch per individual.
+        {
+            if (total_dim != 1)
+                {
+                    return false;
+                }
+            batch_gvalues.resize(individuals.size());
+            for (std::size_t i = 0; i < individuals.size(); ++i)
+                {
+                    const auto& dip
+                        = pop.diploids[offspring_metadata[individuals[i]].label];
+                    double h1 = sum_haplotype_effect_sizes(
+                        pop.haploid_genomes[dip.first].smutations, pop.mutations);
+                    double h2 = sum_haplotype_effect_sizes(
+                        pop.haploid_genomes[dip.second].smutations, pop.mutations);
+                    batch_gvalues[i] = sqrt(h1 * h2);
+                }
+            return true;
+        }
+
         void
         update(const fwdpy11::DiploidPopulation& /*pop*/) override
         {
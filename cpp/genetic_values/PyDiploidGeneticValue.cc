@@ -16,7 +16,11 @@
 // You should have received a copy of the GNU General Public License
 // along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
 //
+#include <cstdint>
+#include <stdexcept>
 #include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <fwdpy11/numpy/array.hpp>
 #include <fwdpy11/genetic_values/DiploidGeneticValue.hpp>
 #include <fwdpy11/genetic_value_to_fitness/GeneticValueIsTrait.hpp>
 #include <fwdpp/fitness_models.hpp>
@@ -43,6 +47,62 @@ struct PyDiploidGeneticValueData
     }
 };
 
+struct PyDiploidGeneticValueBatchData
+// Input to the batch interface, created once per generation
+// per genetic value object.  The arrays own copies of their data.
+{
+    py::object rng, pop;
+    py::array offspring_metadata, offspring_metadata_indexes;
+    // CSR representation of the selected mutation keys of each
+    // offspring genome.  Genome 2*i + j is genome j of the
+    // i-th row of offspring_metadata.
+    py::array genome_offsets, genome_keys;
+    py::array positions, effect_sizes, dominance;
+
+    PyDiploidGeneticValueBatchData(
+        const fwdpy11::GSLrng_t& rng_, const fwdpy11::DiploidPopulation& pop_,
+        const std::vector<fwdpy11::DiploidMetadata>& all_offspring_metadata,
+        const std::vector<std::size_t>& individuals)
+        : rng{py::cast(rng_, py::return_value_policy::reference)},
+          pop{py::cast(pop_, py::return_value_policy::reference)}
+    {
+        std::vector<fwdpy11::DiploidMetadata> md;
+        std::vector<std::uint64_t> offsets{0};
+        std::vector<std::uint32_t> keys;
+        md.reserve(individuals.size());
+        offsets.reserve(2 * individuals.size() + 1);
+        for (auto i : individuals)
+            {
+                md.push_back(all_offspring_metadata[i]);
+                const auto& dip = pop_.diploids[all_offspring_metadata[i].label];
+                for (auto g : {dip.first, dip.second})
+                    {
+                        const auto& smutations = pop_.haploid_genomes[g].smutations;
+                        keys.insert(end(keys), begin(smutations), end(smutations));
+                        offsets.push_back(keys.size());
+                    }
+            }
+        std::vector<double> pos, s, h;
+        pos.reserve(pop_.mutations.size());
+        s.reserve(pop_.mutations.size());
+        h.reserve(pop_.mutations.size());
+        for (const auto& m : pop_.mutations)
+            {
+                pos.push_back(m.pos);
+                s.push_back(m.s);
+                h.push_back(m.h);
+            }
+        offspring_metadata = fwdpy11::make_1d_array_with_capsule(std::move(md));
+        offspring_metadata_indexes = fwdpy11::make_1d_array_with_capsule(
+            std::vector<std::size_t>(individuals));
+        genome_offsets = fwdpy11::make_1d_array_with_capsule(std::move(offsets));
+        genome_keys = fwdpy11::make_1d_array_with_capsule(std::move(keys));
+        positions = fwdpy11::make_1d_array_with_capsule(std::move(pos));
+        effect_sizes = fwdpy11::make_1d_array_with_capsule(std::move(s));
+        dominance = fwdpy11::make_1d_array_with_capsule(std::move(h));
+    }
+};
+
 class PyDiploidGeneticValue : public fwdpy11::DiploidGeneticValue
 {
   public:
@@ -83,6 +143,53 @@ class PyDiploidGeneticValueTrampoline : public PyDiploidGeneticValue
         return this->gv2w->operator()(input_data);
     }
 
+    bool
+    genetic_value_to_fitness_batch(const double* batch_gvalues, const double* g,
+                                   const double* e, std::size_t n,
+                                   double* w) const override
+    {
+        pybind11::gil_scoped_acquire gil;
+        // A Python override must see every individual
+        if (pybind11::get_overload(this, "genetic_value_to_fitness"))
+            {
+                return false;
+            }
+        return PyDiploidGeneticValue::genetic_value_to_fitness_batch(batch_gvalues, g,
+                                                                     e, n, w);
+    }
+
+    bool
+    calculate_gvalues(const fwdpy11::GSLrng_t& rng,
+                      const fwdpy11::DiploidPopulation& pop,
+                      const std::vector<fwdpy11::DiploidMetadata>& offspring_metadata,
+                      const std::vector<std::size_t>& individuals,
+                      std::vector<double>& batch_gvalues) override
+    {
+        pybind11::gil_scoped_acquire gil;
+        pybind11::function overload = pybind11::get_overload(this, "calculate_gvalues");
+        if (!overload)
+            {
+                return false;
+            }
+        auto obj = overload(
+            PyDiploidGeneticValueBatchData(rng, pop, offspring_metadata, individuals));
+        if (obj.is_none())
+            {
+                return false;
+            }
+        auto rv = obj.cast<
+            py::array_t<double, py::array::c_style | py::array::forcecast>>();
+        const auto ndim = static_cast<py::ssize_t>(total_dim);
+        if (rv.size() != static_cast<py::ssize_t>(individuals.size()) * ndim
+            || rv.ndim() > 2 || (rv.ndim() == 2 && rv.shape(1) != ndim))
+            {
+                throw std::invalid_argument(
+                    "calculate_gvalues must return an array of shape (N, ndim)");
+            }
+        batch_gvalues.assign(rv.data(), rv.data() + rv.size());
+        return true;
+    }
+
     void
     update(const fwdpy11::DiploidPopulation& pop) override
     {
@@ -161,6 +268,19 @@ init_PyDiploidGeneticValue(py::module& m)
                 {self.gvalues.get().size()}, {sizeof(double)});
         });
 
+    py::class_<PyDiploidGeneticValueBatchData>(m, "PyDiploidGeneticValueBatchData")
+        .def_readonly("rng", &PyDiploidGeneticValueBatchData::rng)
+        .def_readonly("pop", &PyDiploidGeneticValueBatchData::pop)
+        .def_readonly("offspring_metadata",
+                      &PyDiploidGeneticValueBatchData::offspring_metadata)
+        .def_readonly("offspring_metadata_indexes",
+                      &PyDiploidGeneticValueBatchData::offspring_metadata_indexes)
+        .def_readonly("genome_offsets", &PyDiploidGeneticValueBatchData::genome_offsets)
+        .def_readonly("genome_keys", &PyDiploidGeneticValueBatchData::genome_keys)
+        .def_readonly("positions", &PyDiploidGeneticValueBatchData::positions)
+        .def_readonly("effect_sizes", &PyDiploidGeneticValueBatchData::effect_sizes)
+        .def_readonly("dominance", &PyDiploidGeneticValueBatchData::dominance);
+
     m.def("strict_additive_effects", &strict_additive_effects);
     m.def("additive_effects", &additive_effects);
 }
@@ -8,6 +8,7 @@ void init_Additive(py::module&);
 void init_Multiplicative(py::module&);
 void init_GBR(py::module&);
 void init_DiploidMultivariateEffectsStrictAdditive(py::module&);
+void init_CFunctionGeneticValue(py::module&);
 void init_dgvalue_pointer_vector(py::module&);
 
 void
@@ -24,6 +25,7 @@ init_genetic_value_classes(py::module& m)
     init_Multiplicative(m);
     init_GBR(m);
     init_DiploidMultivariateEffectsStrictAdditive(m);
+    init_CFunctionGeneticValue(m);
 }
 
 void
@@ -9,6 +9,7 @@
 #include <fwdpy11/numpy/array.hpp>
 #include <fwdpp/ts/tree_visitor.hpp>
 #include <fwdpp/ts/detail/generate_data_matrix_details.hpp>
+#include <core/ts/packed_genotype_matrix.hpp>
 
 namespace py = pybind11;
 
@@ -499,6 +500,17 @@ class DataMatrixIterator
     {
         return fwdpy11::make_1d_ndarray_readonly(dmatrix->selected_keys);
     }
+
+    fwdpy11_core::packed_data_matrix
+    packed(const std::string& packing) const
+    {
+        if (dmatrix == nullptr)
+            {
+                throw std::runtime_error("DataMatrix is nullptr");
+            }
+        return fwdpy11_core::pack_data_matrix(
+            *dmatrix, fwdpy11_core::genotype_packing_from_string(packing));
+    }
 };
 
 void
@@ -519,5 +531,6 @@ init_DataMatrixIterator(py::module& m)
         .def_property_readonly("_selected", &DataMatrixIterator::selected)
         .def_property_readonly("_selected_keys", &DataMatrixIterator::selected_keys)
         .def_property_readonly("_selected_positions",
-                               &DataMatrixIterator::selected_positions);
+                               &DataMatrixIterator::selected_positions)
+        .def("_packed", &DataMatrixIterator::packed, py::arg("packing"));
 }
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <memory>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
@@ -15,8 +17,108 @@ PYBIND11_MAKE_OPAQUE(fwdpp::ts::std_table_collection::edge_table);
 PYBIND11_MAKE_OPAQUE(fwdpp::ts::std_table_collection::node_table);
 PYBIND11_MAKE_OPAQUE(fwdpp::ts::std_table_collection::mutation_table);
 
+namespace
+{
+    struct tree_location
+    // The tree containing a position, and the number of
+    // edges inserted and removed by a tree_visitor before
+    // reaching it.
+    {
+        double left;
+        std::size_t ninserted, nremoved;
+    };
+
+    tree_location
+    locate_tree(const fwdpp::ts::std_table_collection& tables, double position)
+    // Binary searches of the edge table indexes.
+    {
+        const auto& edges = tables.edges;
+        if (tables.input_left.size() != edges.size()
+            || tables.output_right.size() != edges.size())
+            {
+                throw std::invalid_argument("edge table is not indexed");
+            }
+        auto j = std::upper_bound(begin(tables.input_left), end(tables.input_left),
+                                  position, [&edges](double x, std::size_t i) {
+                                      return x < edges[i].left;
+                                  });
+        auto k = std::upper_bound(begin(tables.output_right), end(tables.output_right),
+                                  position, [&edges](double x, std::size_t i) {
+                                      return x < edges[i].right;
+                                  });
+        tree_location rv{0.0,
+                         static_cast<std::size_t>(j - begin(tables.input_left)),
+                         static_cast<std::size_t>(k - begin(tables.output_right))};
+        if (rv.ninserted > 0)
+            {
+                rv.left = std::max(rv.left, edges[*(j - 1)].left);
+            }
+        if (rv.nremoved > 0)
+            {
+                rv.left = std::max(rv.left, edges[*(k - 1)].right);
+            }
+        return rv;
+    }
+
+    std::size_t
+    rebuild_cost(const fwdpp::ts::std_table_collection& tables,
+                 const tree_location& location)
+    // Work done by tables_starting_at
+    {
+        return tables.nodes.size() + tables.edges.size() - location.nremoved;
+    }
+
+    std::shared_ptr<fwdpp::ts::std_table_collection>
+    tables_starting_at(const std::shared_ptr<fwdpp::ts::std_table_collection>& tables,
+                       double left)
+    // Returns tables whose edges are the parts of the input edges
+    // from left onwards, where left is the left end of a tree.
+    // A tree_visitor over the result sees one empty tree to the left of
+    // that tree and then the same trees as a visitor of the input.
+    // The input indexes are filtered rather than rebuilt, which keeps
+    // them sorted because clipped edges all start at left and precede
+    // the other edges in input_left.  The sites and mutations are
+    // not copied.
+    {
+        const auto& edges = tables->edges;
+        auto rv = std::make_shared<fwdpp::ts::std_table_collection>(
+            tables->genome_length());
+        rv->nodes = tables->nodes;
+        std::vector<std::size_t> new_index(edges.size());
+        for (std::size_t i = 0; i < edges.size(); ++i)
+            {
+                if (edges[i].right > left)
+                    {
+                        new_index[i] = rv->edges.size();
+                        rv->edges.push_back(edges[i]);
+                        rv->edges.back().left = std::max(edges[i].left, left);
+                    }
+            }
+        rv->input_left.reserve(rv->edges.size());
+        rv->output_right.reserve(rv->edges.size());
+        for (auto i : tables->input_left)
+            {
+                if (edges[i].right > left)
+                    {
+                        rv->input_left.push_back(new_index[i]);
+                    }
+            }
+        for (auto i : tables->output_right)
+            {
+                if (edges[i].right > left)
+                    {
+                        rv->output_right.push_back(new_index[i]);
+                    }
+            }
+        return rv;
+    }
+}
+
 class tree_visitor_wrapper
 {
+  public:
+    using visitor_t = fwdpp::ts::tree_visitor<fwdpp::ts::std_table_collection>;
+
   private:
     inline fwdpp::ts::table_index_t
     fetch(const std::vector<fwdpp::ts::table_index_t>& data,
@@ -39,6 +141,59 @@ class tree_visitor_wrapper
             }
     }
 
+    void
+    reset_visitor(const tree_location& location)
+    // Visit the trees of tables_, or of a copy starting at
+    // the tree at location if that is less work than
+    // visiting the trees to its left.
+    {
+        if (location.left > 0.0
+            && rebuild_cost(*tables_, location)
+                   < location.ninserted + location.nremoved)
+            {
+                visitor_tables = tables_starting_at(tables_, location.left);
+            }
+        else
+            {
+                visitor_tables = tables_;
+            }
+        if (has_preserved_nodes)
+            {
+                visitor = std::make_shared<visitor_t>(
+                    *visitor_tables, samples_, preserved_nodes_,
+                    fwdpp::ts::update_samples_list(update_samples));
+            }
+        else
+            {
+                visitor = std::make_shared<visitor_t>(
+                    *visitor_tables, samples_,
+                    fwdpp::ts::update_samples_list(update_samples));
+            }
+    }
+
+    void
+    update_site_iterators()
+    {
+        double pos = std::max(visitor->tree().left, from);
+        current_site = std::lower_bound(
+            current_site, end_of_sites, pos,
+            [](const fwdpp::ts::site& s, double value) { return s.position < value; });
+        if (current_site < end_of_sites)
+            {
+                pos = current_site->position;
+                current_mutation = std::lower_bound(
+                    current_mutation, end_of_mutations, pos,
+                    [this](const fwdpp::ts::mutation_record& mr, double value) {
+                        return (first_site + mr.site)->position < value;
+                    });
+                if (current_mutation < end_of_mutations
+                    && (first_site + current_mutation->site)->position != pos)
+                    {
+                        throw std::runtime_error("error site and mutation iterators");
+                    }
+            }
+    }
+
     // We hold a reference to the input
     // TableCollection, which prevents it
     // bad things from happening in the
@@ -50,10 +205,20 @@ class tree_visitor_wrapper
         end_of_mutations, current_mutation;
     bool update_samples;
     const double from, until;
+    std::vector<fwdpp::ts::table_index_t> samples_, preserved_nodes_;
+    bool has_preserved_nodes;
+    // The tables that the visitor iterates over.
+    // These are tables_ unless iteration starts
+    // to the right of the first tree.
+    std::shared_ptr<fwdpp::ts::std_table_collection> visitor_tables;
 
   public:
-    fwdpp::ts::tree_visitor<fwdpp::ts::std_table_collection> visitor;
+    // Shared so that NumPy views of the marginal tree
+    // keep it alive after a seek replaces it.
+    std::shared_ptr<visitor_t> visitor;
     std::vector<fwdpp::ts::table_index_t> samples_below_buffer;
+    // The sample list is the same for all trees
+    std::vector<fwdpp::ts::table_index_t> samples_list;
     tree_visitor_wrapper(std::shared_ptr<fwdpp::ts::std_table_collection> tables,
                          const std::vector<fwdpp::ts::table_index_t>& samples,
                          bool update_samples_below, double start, double stop)
@@ -62,11 +227,14 @@ class tree_visitor_wrapper
           first_mutation(tables_->mutations.begin()),
           end_of_mutations(tables_->mutations.end()), current_mutation(first_mutation),
           update_samples(update_samples_below), from(start), until(stop),
-          visitor(*tables_, samples,
-                  fwdpp::ts::update_samples_list(update_samples_below)),
-          samples_below_buffer()
+          samples_(samples), preserved_nodes_(),
+          has_preserved_nodes(false), visitor_tables(), visitor(),
+          samples_below_buffer(), samples_list()
     {
         validate_from_until(tables_->genome_length());
+        reset_visitor(locate_tree(*tables_, from));
+        samples_list.assign(visitor->tree().samples_list_begin(),
+                            visitor->tree().samples_list_end());
     }
 
     tree_visitor_wrapper(std::shared_ptr<fwdpp::ts::std_table_collection> tables,
@@ -78,66 +246,101 @@ class tree_visitor_wrapper
           first_mutation(tables_->mutations.begin()),
           end_of_mutations(tables_->mutations.end()), current_mutation(first_mutation),
           update_samples(update_samples_below), from(start), until(stop),
-          visitor(*tables_, samples, preserved_nodes,
-                  fwdpp::ts::update_samples_list(update_samples_below)),
-          samples_below_buffer()
+          samples_(samples), preserved_nodes_(preserved_nodes),
+          has_preserved_nodes(true), visitor_tables(), visitor(),
+          samples_below_buffer(), samples_list()
     {
         validate_from_until(tables_->genome_length());
+        reset_visitor(locate_tree(*tables_, from));
+        samples_list.assign(visitor->tree().samples_list_begin(),
+                            visitor->tree().samples_list_end());
     }
 
     inline bool
     operator()()
     {
-        bool rv = false;
-        rv = visitor();
-        while (visitor.tree().right < from)
+        bool rv = (*visitor)();
+        while (rv && visitor->tree().right <= from)
             {
-                rv = visitor();
+                rv = (*visitor)();
             }
-        double pos = std::max(visitor.tree().left, from);
-        current_site = std::lower_bound(
-            current_site, end_of_sites, pos,
-            [](const fwdpp::ts::site& s, double value) { return s.position < value; });
-        if (current_site < end_of_sites)
-            {
-                pos = current_site->position;
-                current_mutation = std::lower_bound(
-                    current_mutation, end_of_mutations, pos,
-                    [this](const fwdpp::ts::mutation_record& mr, double value) {
-                        return (first_site + mr.site)->position < value;
-                    });
-                if (current_mutation < end_of_mutations
-                    && (first_site + current_mutation->site)->position != pos)
-                    {
-                        throw std::runtime_error("error site and mutation iterators");
-                    }
-            }
-        if (visitor.tree().left >= until)
+        update_site_iterators();
+        if (visitor->tree().left >= until)
             {
                 return false;
             }
         return rv;
     }
 
+    void
+    seek(double position)
+    // Make the current tree the one containing position.
+    // The visitor moves forwards if the target is to the right
+    // of the current tree and that is less work than rebuilding.
+    // Otherwise, reset_visitor chooses between starting over
+    // and copying the edges from the target tree onwards.
+    {
+        if (!std::isfinite(position) || position < from || position >= until
+            || position >= tables_->genome_length())
+            {
+                throw std::invalid_argument("position is out of range");
+            }
+        const auto& tree = visitor->tree();
+        if (position >= tree.left && position < tree.right)
+            {
+                return;
+            }
+        const auto target = locate_tree(*tables_, position);
+        bool forwards = false;
+        if (position >= tree.right && tree.right > tree.left)
+            {
+                const auto current = locate_tree(*tables_, tree.left);
+                const auto steps = (target.ninserted - current.ninserted)
+                                   + (target.nremoved - current.nremoved);
+                forwards = steps <= std::min(rebuild_cost(*tables_, target),
+                                             target.ninserted + target.nremoved);
+            }
+        if (!forwards)
+            {
+                reset_visitor(target);
+            }
+        bool rv = (*visitor)();
+        while (rv && visitor->tree().right <= position)
+            {
+                rv = (*visitor)();
+            }
+        if (!rv)
+            {
+                throw std::runtime_error("failed to find tree containing position");
+            }
+        current_site = first_site;
+        current_mutation = first_mutation;
+        update_site_iterators();
+    }
+
     fwdpp::ts::table_index_t
     sample_size() const
     {
-        return visitor.tree().sample_size();
+        return visitor->tree().sample_size();
     }
 
     py::array_t<fwdpp::ts::table_index_t>
     nodes()
     {
-        std::vector<fwdpp::ts::table_index_t> vnodes(nodes_preorder(visitor.tree()));
+        std::vector<fwdpp::ts::table_index_t> vnodes(nodes_preorder(visitor->tree()));
         return fwdpy11::make_1d_array_with_capsule(std::move(vnodes));
     }
 
     py::array_t<fwdpp::ts::table_index_t>
-    samples() const
+    tree_array(const std::vector<fwdpp::ts::table_index_t>& data) const
+    // Read-only view of one of the marginal tree's arrays.
+    // The visitor updates these arrays in place as
+    // iteration proceeds.
     {
-        std::vector<fwdpp::ts::table_index_t> s(visitor.tree().samples_list_begin(),
-                                                visitor.tree().samples_list_end());
-        return fwdpy11::make_1d_array_with_capsule(std::move(s));
+        py::capsule owner(new std::shared_ptr<visitor_t>(visitor), [](void* p) {
+            delete reinterpret_cast<std::shared_ptr<visitor_t>*>(p);
+        });
+        return fwdpy11::make_1d_ndarray_readonly(data, owner);
     }
 
     py::array
@@ -153,7 +356,7 @@ class tree_visitor_wrapper
             }
         samples_below_buffer.clear();
         fwdpp::ts::process_samples(
-            visitor.tree(), fwdpp::ts::convert_sample_index_to_nodes(true), node,
+            visitor->tree(), fwdpp::ts::convert_sample_index_to_nodes(true), node,
             [this](fwdpp::ts::table_index_t s) { samples_below_buffer.push_back(s); });
         if (sorted)
             {
@@ -165,43 +368,43 @@ class tree_visitor_wrapper
     fwdpp::ts::table_index_t
     parent(fwdpp::ts::table_index_t u)
     {
-        return fetch(this->visitor.tree().parents, u);
+        return fetch(this->visitor->tree().parents, u);
     }
 
     fwdpp::ts::table_index_t
     left_sib(fwdpp::ts::table_index_t u)
     {
-        return fetch(this->visitor.tree().left_sib, u);
+        return fetch(this->visitor->tree().left_sib, u);
     }
 
     fwdpp::ts::table_index_t
     right_sib(fwdpp::ts::table_index_t u)
     {
-        return fetch(this->visitor.tree().right_sib, u);
+        return fetch(this->visitor->tree().right_sib, u);
     }
 
     fwdpp::ts::table_index_t
     left_child(fwdpp::ts::table_index_t u)
     {
-        return fetch(this->visitor.tree().left_child, u);
+        return fetch(this->visitor->tree().left_child, u);
     }
 
     fwdpp::ts::table_index_t
     right_child(fwdpp::ts::table_index_t u)
     {
-        return fetch(this->visitor.tree().right_child, u);
+        return fetch(this->visitor->tree().right_child, u);
     }
 
     fwdpp::ts::table_index_t
     leaf_counts(fwdpp::ts::table_index_t u)
     {
-        return fetch(this->visitor.tree().leaf_counts, u);
+        return fetch(this->visitor->tree().leaf_counts, u);
     }
 
     fwdpp::ts::table_index_t
     preserved_leaf_counts(fwdpp::ts::table_index_t u)
     {
-        return fetch(this->visitor.tree().preserved_leaf_counts, u);
+        return fetch(this->visitor->tree().preserved_leaf_counts, u);
     }
 
     std::shared_ptr<fwdpp::ts::std_table_collection>
@@ -214,8 +417,8 @@ class tree_visitor_wrapper
               fwdpp::ts::std_table_collection::site_table::const_iterator>
     get_sites_on_current_tree()
     {
-        double pos = std::min(visitor.tree().right, until);
-        while (current_site->position < visitor.tree().left)
+        double pos = std::min(visitor->tree().right, until);
+        while (current_site->position < visitor->tree().left)
             {
                 ++current_site;
             }
@@ -247,9 +450,9 @@ class tree_visitor_wrapper
               fwdpp::ts::std_table_collection::mutation_table::const_iterator>
     get_mutations_on_current_tree()
     {
-        double pos = std::min(visitor.tree().right, until);
+        double pos = std::min(visitor->tree().right, until);
         while ((current_site < end_of_sites)
-               && (current_site->position < visitor.tree().left))
+               && (current_site->position < visitor->tree().left))
             {
                 ++current_site;
             }
@@ -310,10 +513,10 @@ init_tree_iterator(py::module& m)
         .def("_right_child", &tree_visitor_wrapper::right_child)
         .def_property_readonly(
             "_left",
-            [](const tree_visitor_wrapper& self) { return self.visitor.tree().left; })
+            [](const tree_visitor_wrapper& self) { return self.visitor->tree().left; })
         .def_property_readonly(
             "_right",
-            [](const tree_visitor_wrapper& self) { return self.visitor.tree().right; })
+            [](const tree_visitor_wrapper& self) { return self.visitor->tree().right; })
         .def("__next__",
              [](tree_visitor_wrapper& self) -> tree_visitor_wrapper& {
                  auto x = self();
@@ -328,7 +531,7 @@ init_tree_iterator(py::module& m)
         .def("_total_time",
              [](const tree_visitor_wrapper& self,
                 const fwdpp::ts::std_table_collection::node_table& nodes) {
-                 const auto& m = self.visitor.tree();
+                 const auto& m = self.visitor->tree();
                  if (m.parents.size() != nodes.size())
                      {
                          throw std::invalid_argument(
@@ -349,11 +552,34 @@ init_tree_iterator(py::module& m)
         .def_property_readonly(
             "_roots",
             [](const tree_visitor_wrapper& self) {
-                auto roots = fwdpp::ts::get_roots(self.visitor.tree());
+                auto roots = fwdpp::ts::get_roots(self.visitor->tree());
                 return fwdpy11::make_1d_array_with_capsule(std::move(roots));
             })
         .def("_nodes", &tree_visitor_wrapper::nodes)
-        .def("_samples", &tree_visitor_wrapper::samples)
+        .def("_samples",
+             [](py::object self) {
+                 const auto& s = self.cast<const tree_visitor_wrapper&>().samples_list;
+                 return fwdpy11::make_1d_ndarray_readonly(s, self);
+             })
+        .def_property_readonly("_parent_array",
+                               [](const tree_visitor_wrapper& self) {
+                                   return self.tree_array(self.visitor->tree().parents);
+                               })
+        .def_property_readonly("_left_child_array",
+                               [](const tree_visitor_wrapper& self) {
+                                   return self.tree_array(
+                                       self.visitor->tree().left_child);
+                               })
+        .def_property_readonly("_right_sib_array",
+                               [](const tree_visitor_wrapper& self) {
+                                   return self.tree_array(self.visitor->tree().right_sib);
+                               })
+        .def_property_readonly("_leaf_counts_array",
+                               [](const tree_visitor_wrapper& self) {
+                                   return self.tree_array(
+                                       self.visitor->tree().leaf_counts);
+                               })
+        .def("_seek", &tree_visitor_wrapper::seek, py::arg("position"))
         .def_property_readonly("_tables", &tree_visitor_wrapper::get_tables)
         .def("_samples_below", &tree_visitor_wrapper::samples_below, py::arg("node"),
              py::arg("sorted") = false)
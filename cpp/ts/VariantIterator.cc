@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
@@ -9,10 +12,14 @@
 
 namespace py = pybind11;
 
+PYBIND11_MAKE_OPAQUE(fwdpy11::Population::mutation_container);
+
 class VariantIterator
 {
   private:
     using site_table_itr = fwdpp::ts::std_table_collection::site_table::const_iterator;
+    using mut_table_itr
+        = fwdpp::ts::std_table_collection::mutation_table::const_iterator;
     fwdpp::ts::site_visitor<fwdpp::ts::std_table_collection> sv;
     site_table_itr scurrent, send;
     std::vector<std::int8_t> genotype_data;
@@ -20,6 +27,31 @@ class VariantIterator
     double from, to;
     fwdpp::ts::convert_sample_index_to_nodes convert;
     py::list mutation_records;
+    // State of chunked iteration: the mutations of the
+    // current site that have not yet been considered.
+    mut_table_itr chunk_mcurrent, chunk_mend;
+    bool chunks_exhausted;
+
+    bool
+    next_chunk_site()
+    {
+        if (chunks_exhausted)
+            {
+                return false;
+            }
+        while ((scurrent = sv()) != end(sv) && scurrent->position < to)
+            {
+                if (scurrent->position >= from)
+                    {
+                        auto m = sv.get_mutations();
+                        chunk_mcurrent = m.first;
+                        chunk_mend = m.second;
+                        return true;
+                    }
+            }
+        chunks_exhausted = true;
+        return false;
+    }
 
   public:
     py::array_t<std::int8_t> genotypes;
@@ -32,8 +64,8 @@ class VariantIterator
         : sv(tc, samples), scurrent(begin(tc.sites)), send(std::end(tc.sites)),
           genotype_data(samples.size(), 0), include_neutral(include_neutral_variant),
           include_selected(include_selected_variants), from(beg), to(end),
-          convert(false), mutation_records{},
-          genotypes(fwdpy11::make_1d_ndarray(genotype_data)),
+          convert(false), mutation_records{}, chunk_mcurrent{}, chunk_mend{},
+          chunks_exhausted(false), genotypes(fwdpy11::make_1d_ndarray(genotype_data)),
           current_position(std::numeric_limits<double>::quiet_NaN())
     {
         if (!include_selected && !include_neutral)
@@ -125,6 +157,95 @@ class VariantIterator
     {
         return mutation_records;
     }
+
+    std::size_t
+    fill_chunk(py::array_t<std::int8_t, py::array::c_style> genotype_chunk,
+               py::array_t<double, py::array::c_style> positions,
+               py::array_t<std::uint64_t, py::array::c_style> keys,
+               py::array_t<double, py::array::c_style> effect_sizes,
+               py::object mutations, std::vector<std::uint16_t> labels,
+               double min_maf)
+    // Fills up to genotype_chunk.shape[0] rows, one per mutation,
+    // and returns the number of rows filled.
+    {
+        const auto nsamples = genotype_data.size();
+        if (genotype_chunk.ndim() != 2
+            || static_cast<std::size_t>(genotype_chunk.shape(1)) != nsamples)
+            {
+                throw std::invalid_argument(
+                    "genotype array must have one column per sample");
+            }
+        const auto nrows = static_cast<std::size_t>(genotype_chunk.shape(0));
+        if (static_cast<std::size_t>(positions.size()) < nrows
+            || static_cast<std::size_t>(keys.size()) < nrows
+            || static_cast<std::size_t>(effect_sizes.size()) < nrows)
+            {
+                throw std::invalid_argument(
+                    "position, key, and effect size arrays are too short");
+            }
+        const fwdpy11::Population::mutation_container* mvec = nullptr;
+        if (!mutations.is_none())
+            {
+                mvec = &mutations.cast<const fwdpy11::Population::mutation_container&>();
+            }
+        if (!labels.empty() && mvec == nullptr)
+            {
+                throw std::invalid_argument("filtering on labels requires mutations");
+            }
+        std::sort(begin(labels), end(labels));
+
+        auto g = genotype_chunk.mutable_data();
+        auto p = positions.mutable_data();
+        auto k = keys.mutable_data();
+        auto e = effect_sizes.mutable_data();
+        std::size_t row = 0;
+        py::gil_scoped_release release;
+        while (row < nrows)
+            {
+                if (!(chunk_mcurrent < chunk_mend))
+                    {
+                        if (!next_chunk_site())
+                            {
+                                break;
+                            }
+                        continue;
+                    }
+                const auto i = chunk_mcurrent++;
+                if ((i->neutral && !include_neutral) || (!i->neutral && !include_selected))
+                    {
+                        continue;
+                    }
+                if (mvec != nullptr && i->key >= mvec->size())
+                    {
+                        throw std::invalid_argument("mutation key out of range");
+                    }
+                if (!labels.empty()
+                    && !std::binary_search(begin(labels), end(labels),
+                                           (*mvec)[i->key].xtra))
+                    {
+                        continue;
+                    }
+                auto rowdata = g + row * nsamples;
+                std::fill(rowdata, rowdata + nsamples, scurrent->ancestral_state);
+                std::size_t n = 0;
+                fwdpp::ts::process_samples(sv.current_tree(), convert, i->node,
+                                           [rowdata, i, &n](fwdpp::ts::table_index_t u) {
+                                               ++n;
+                                               rowdata[u] = i->derived_state;
+                                           });
+                const double f = static_cast<double>(n) / static_cast<double>(nsamples);
+                if (n == 0 || std::min(f, 1.0 - f) < min_maf)
+                    {
+                        continue;
+                    }
+                p[row] = scurrent->position;
+                k[row] = i->key;
+                e[row] = (mvec == nullptr) ? std::numeric_limits<double>::quiet_NaN()
+                                           : (*mvec)[i->key].s;
+                ++row;
+            }
+        return row;
+    }
 };
 
 void
@@ -148,6 +269,9 @@ init_variant_iterator(py::module& m)
         .def_readonly("_genotypes", &VariantIterator::genotypes)
         .def_property_readonly("site", &VariantIterator::current_site)
         .def_property_readonly("_records", &VariantIterator::records)
-        .def_readonly("_position", &VariantIterator::current_position);
+        .def_readonly("_position", &VariantIterator::current_position)
+        .def("_fill_chunk", &VariantIterator::fill_chunk, py::arg("genotypes"),
+             py::arg("positions"), py::arg("keys"), py::arg("effect_sizes"),
+             py::arg("mutations"), py::arg("labels"), py::arg("min_maf"));
 }
 
@@ -0,0 +1,45 @@
+#include <utility>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/numpy/array.hpp>
+#include <core/ts/association_scan.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    py::tuple
+    association_scan(const fwdpp::ts::std_table_collection& tables,
+                     const std::vector<fwdpp::ts::table_index_t>& samples,
+                     const std::vector<double>& phenotypes,
+                     const std::vector<double>& covariates, std::size_t ncovariates,
+                     bool record_neutral, bool record_selected,
+                     std::size_t sites_per_chunk, std::size_t num_threads)
+    // (positions, keys, derived_counts, beta, se, pvalue)
+    {
+        fwdpy11_core::association_scan_result rv;
+        {
+            py::gil_scoped_release release;
+            rv = fwdpy11_core::association_scan(
+                tables, samples, phenotypes, covariates, ncovariates, record_neutral,
+                record_selected, sites_per_chunk, num_threads);
+        }
+        return py::make_tuple(
+            fwdpy11::make_1d_array_with_capsule(std::move(rv.positions)),
+            fwdpy11::make_1d_array_with_capsule(std::move(rv.keys)),
+            fwdpy11::make_1d_array_with_capsule(std::move(rv.derived_counts)),
+            fwdpy11::make_1d_array_with_capsule(std::move(rv.beta)),
+            fwdpy11::make_1d_array_with_capsule(std::move(rv.se)),
+            fwdpy11::make_1d_array_with_capsule(std::move(rv.pvalue)));
+    }
+}
+
+void
+init_association_scan(py::module& m)
+{
+    m.def("_association_scan", &association_scan, py::arg("tables"), py::arg("samples"),
+          py::arg("phenotypes"), py::arg("covariates"), py::arg("ncovariates"),
+          py::arg("record_neutral"), py::arg("record_selected"),
+          py::arg("sites_per_chunk"), py::arg("num_threads"));
+}
@@ -1,14 +1,51 @@
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
 #include <fwdpy11/types/Population.hpp>
 #include <fwdpy11/numpy/array.hpp>
 #include <fwdpp/ts/count_mutations.hpp>
+#include <core/ts/tree_statistics.hpp>
 
 namespace py = pybind11;
 
 PYBIND11_MAKE_OPAQUE(std::vector<fwdpy11::Mutation>);
 
+namespace
+{
+    py::array_t<std::uint32_t>
+    count_mutations_by_sample_set(const fwdpp::ts::std_table_collection& tables,
+                                  std::size_t nmutations,
+                                  const std::vector<std::int32_t>& sample_set_of_node,
+                                  int nsets)
+    {
+        if (nsets < 0)
+            {
+                throw std::invalid_argument("nsets must be >= 0");
+            }
+        std::size_t K = static_cast<std::size_t>(nsets);
+        if (K == 0)
+            {
+                auto m = std::max_element(begin(sample_set_of_node),
+                                          end(sample_set_of_node));
+                if (m == end(sample_set_of_node) || *m < 0)
+                    {
+                        throw std::invalid_argument("no nodes are in a sample set");
+                    }
+                K = static_cast<std::size_t>(*m) + 1;
+            }
+        std::vector<std::uint32_t> rv;
+        {
+            py::gil_scoped_release release;
+            rv = fwdpy11_core::count_mutations_by_sample_set(tables, sample_set_of_node,
+                                                             K, nmutations);
+        }
+        return fwdpy11::make_2d_array_with_capsule(std::move(rv), nmutations, K);
+    }
+}
+
 void
 init_count_mutations(py::module& m)
 {
@@ -54,4 +91,70 @@ init_count_mutations(py::module& m)
           :return: Array of mutation counts
           :rtype: numpy.ndarray
           )delim");
+
+    m.def(
+        "count_mutations_by_sample_set",
+        [](const fwdpy11::Population& pop,
+           const std::vector<std::int32_t>& sample_set_of_node, int nsets) {
+            return count_mutations_by_sample_set(*pop.tables, pop.mutations.size(),
+                                                 sample_set_of_node, nsets);
+        },
+        py::arg("pop"), py::arg("sample_set_of_node"), py::arg("nsets") = 0,
+        R"delim(
+          Count mutation occurrences in several sample sets
+          with one pass over the trees.
+
+          :param pop: A population
+          :type pop: :class:`fwdpy11.Population`
+          :param sample_set_of_node: The sample set of each node, or -1
+          :type sample_set_of_node: list or numpy.ndarray
+          :param nsets: (0) Number of sample sets.  If 0, one more
+                        than the largest value in `sample_set_of_node`.
+          :type nsets: int
+
+          :return: Mutation counts, with one row per mutation and
+                   one column per sample set
+          :rtype: numpy.ndarray
+
+          `sample_set_of_node` must have one entry per node.
+          Row ``i`` of the return value refers to mutation ``i``,
+          as for :func:`fwdpy11.count_mutations`.
+
+          A typical use is counting mutations in each set of
+          ancient samples, which gives allele frequency trajectories
+          for the cost of a single traversal.
+
+          .. versionadded:: 0.25.0
+          )delim");
+
+    m.def(
+        "count_mutations_by_sample_set",
+        [](const fwdpp::ts::std_table_collection& tables,
+           const std::vector<fwdpy11::Mutation>& mutations,
+           const std::vector<std::int32_t>& sample_set_of_node, int nsets) {
+            return count_mutations_by_sample_set(tables, mutations.size(),
+                                                 sample_set_of_node, nsets);
+        },
+        py::arg("tables"), py::arg("mutations"), py::arg("sample_set_of_node"),
+        py::arg("nsets") = 0,
+        R"delim(
+          Count mutation occurrences in several sample sets
+          with one pass over the trees.
+
+          :param tables: A table collection
+          :type tables: :class:`fwdpy11.ts.TableCollection`
+          :param mutations: Mutation list
+          :type mutations: :class:`fwdpy11.VecMutation`
+          :param sample_set_of_node: The sample set of each node, or -1
+          :type sample_set_of_node: list or numpy.ndarray
+          :param nsets: (0) Number of sample sets.  If 0, one more
+                        than the largest value in `sample_set_of_node`.
+          :type nsets: int
+
+          :return: Mutation counts, with one row per mutation and
+                   one column per sample set
+          :rtype: numpy.ndarray
+
+          .. versionadded:: 0.25.0
+          )delim");
 }
@@ -2,6 +2,7 @@
 #include <fwdpy11/types/Population.hpp>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <core/ts/windowed_data_matrices.hpp>
 
 namespace py = pybind11;
 
@@ -18,6 +19,33 @@ generate_data_matrix(const fwdpp::ts::std_table_collection& tables,
                                            stop);
 }
 
+py::list
+windowed_data_matrices(const fwdpp::ts::std_table_collection& tables,
+                       const std::vector<fwdpp::ts::table_index_t>& samples,
+                       const std::vector<std::pair<double, double>>& intervals,
+                       bool record_neutral, bool record_selected, bool include_fixations,
+                       std::size_t num_threads)
+{
+    std::vector<fwdpp::data_matrix> matrices;
+    {
+        py::gil_scoped_release release;
+        matrices.resize(intervals.size(), fwdpp::data_matrix(samples.size()));
+        fwdpy11_core::windowed_data_matrices(
+            tables, samples, intervals, record_neutral, record_selected,
+            include_fixations, num_threads,
+            [&matrices](std::size_t window, fwdpp::data_matrix& dm) {
+                // Each window has its own slot, so no locking is needed.
+                std::swap(matrices[window], dm);
+            });
+    }
+    py::list rv;
+    for (auto& dm : matrices)
+        {
+            rv.append(py::cast(std::move(dm)));
+        }
+    return rv;
+}
+
 void
 init_data_matrix_from_tables(py::module& m)
 {
@@ -36,4 +64,9 @@ init_data_matrix_from_tables(py::module& m)
           py::arg("samples"), py::arg("record_neutral"), py::arg("record_selected"),
           py::arg("include_fixations") = false, py::arg("begin") = 0.0,
           py::arg("end") = std::numeric_limits<double>::max());
+
+    m.def("_windowed_data_matrices", &windowed_data_matrices, py::arg("tables"),
+          py::arg("samples"), py::arg("intervals"), py::arg("record_neutral"),
+          py::arg("record_selected"), py::arg("include_fixations"),
+          py::arg("num_threads"));
 }
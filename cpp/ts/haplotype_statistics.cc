@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <utility>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpp/data_matrix.hpp>
+#include <fwdpy11/numpy/array.hpp>
+#include <core/ts/packed_genotype_matrix.hpp>
+#include <core/ts/haplotype_statistics.hpp>
+#include "packed_rows.hpp"
+
+namespace py = pybind11;
+
+namespace
+{
+    using fwdpy11_core::packed_data_matrix;
+    using fwdpy11_core::packed_genotype_matrix;
+
+    template <typename Matrix>
+    py::tuple
+    haplotype_scan(const Matrix& m, bool neutral, bool selected, double min_ehh,
+                   double min_maf, bool include_edges, std::size_t num_threads)
+    // (positions, keys, derived allele counts, ihh_ancestral,
+    //  ihh_derived, ihs, sl_ancestral, sl_derived, nsl)
+    {
+        packed_genotype_matrix rows(fwdpy11_core::genotype_packing::haplotype, 0);
+        std::vector<std::uint32_t> counts;
+        fwdpy11_core::haplotype_scan_result scan;
+        {
+            py::gil_scoped_release release;
+            rows = packed_rows(m, neutral, selected);
+            counts = fwdpy11_core::allele_counts(rows);
+            scan = fwdpy11_core::haplotype_scan(
+                rows, fwdpy11_core::haplotype_scan_options{min_ehh, min_maf,
+                                                           include_edges, num_threads});
+        }
+        return py::make_tuple(
+            fwdpy11::make_1d_array_with_capsule(std::move(rows.positions)),
+            fwdpy11::make_1d_array_with_capsule(std::move(rows.keys)),
+            fwdpy11::make_1d_array_with_capsule(std::move(counts)),
+            fwdpy11::make_1d_array_with_capsule(std::move(scan.ihh_ancestral)),
+            fwdpy11::make_1d_array_with_capsule(std::move(scan.ihh_derived)),
+            fwdpy11::make_1d_array_with_capsule(std::move(scan.ihs)),
+            fwdpy11::make_1d_array_with_capsule(std::move(scan.sl_ancestral)),
+            fwdpy11::make_1d_array_with_capsule(std::move(scan.sl_derived)),
+            fwdpy11::make_1d_array_with_capsule(std::move(scan.nsl)));
+    }
+
+    template <typename Matrix>
+    py::tuple
+    ehh_decay(const Matrix& m, bool neutral, bool selected, std::size_t core)
+    // (positions, ehh_ancestral, ehh_derived)
+    {
+        packed_genotype_matrix rows(fwdpy11_core::genotype_packing::haplotype, 0);
+        std::vector<double> ancestral, derived;
+        {
+            py::gil_scoped_release release;
+            rows = packed_rows(m, neutral, selected);
+            fwdpy11_core::ehh_decay(rows, core, ancestral, derived);
+        }
+        return py::make_tuple(
+            fwdpy11::make_1d_array_with_capsule(std::move(rows.positions)),
+            fwdpy11::make_1d_array_with_capsule(std::move(ancestral)),
+            fwdpy11::make_1d_array_with_capsule(std::move(derived)));
+    }
+}
+
+void
+init_haplotype_statistics(py::module& m)
+{
+    m.def("_haplotype_scan", &haplotype_scan<packed_data_matrix>, py::arg("matrix"),
+          py::arg("neutral"), py::arg("selected"), py::arg("min_ehh"),
+          py::arg("min_maf"), py::arg("include_edges"), py::arg("num_threads"));
+
+    m.def("_haplotype_scan", &haplotype_scan<fwdpp::data_matrix>, py::arg("matrix"),
+          py::arg("neutral"), py::arg("selected"), py::arg("min_ehh"),
+          py::arg("min_maf"), py::arg("include_edges"), py::arg("num_threads"));
+
+    m.def("_ehh_decay", &ehh_decay<packed_data_matrix>, py::arg("matrix"),
+          py::arg("neutral"), py::arg("selected"), py::arg("core"));
+
+    m.def("_ehh_decay", &ehh_decay<fwdpp::data_matrix>, py::arg("matrix"),
+          py::arg("neutral"), py::arg("selected"), py::arg("core"));
+}
@@ -0,0 +1,39 @@
+#include <utility>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/numpy/array.hpp>
+#include <core/ts/ibd_segments.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    py::tuple
+    ibd_segments(const fwdpp::ts::std_table_collection& tables,
+                 const std::vector<fwdpp::ts::table_index_t>& samples,
+                 const std::vector<std::pair<fwdpp::ts::table_index_t,
+                                             fwdpp::ts::table_index_t>>& pairs,
+                 double min_length)
+    // (first, second, left, right, node, time)
+    {
+        fwdpy11_core::ibd_segments rv;
+        {
+            py::gil_scoped_release release;
+            rv = fwdpy11_core::find_ibd_segments(tables, samples, pairs, min_length);
+        }
+        return py::make_tuple(fwdpy11::make_1d_array_with_capsule(std::move(rv.first)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(rv.second)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(rv.left)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(rv.right)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(rv.node)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(rv.time)));
+    }
+}
+
+void
+init_ibd_segments(py::module& m)
+{
+    m.def("_ibd_segments", &ibd_segments, py::arg("tables"), py::arg("samples"),
+          py::arg("pairs"), py::arg("min_length"));
+}
@@ -7,7 +7,14 @@ void init_variant_iterator(py::module&);
 void init_count_mutations(py::module&);
 void init_simplify_functions(py::module&);
 void init_data_matrix_from_tables(py::module&);
+void init_packed_genotype_matrix(py::module&);
 void init_infinite_sites(py::module&);
+void init_node_genetic_values(py::module&);
+void init_tree_statistics(py::module&);
+void init_linkage_disequilibrium(py::module&);
+void init_haplotype_statistics(py::module&);
+void init_association_scan(py::module&);
+void init_ibd_segments(py::module&);
 void
 init_DataMatrixIterator(py::module& m);
 
@@ -19,6 +26,13 @@ init_ts(py::module& m)
     init_count_mutations(m);
     init_simplify_functions(m);
     init_data_matrix_from_tables(m);
+    init_packed_genotype_matrix(m);
     init_infinite_sites(m);
+    init_node_genetic_values(m);
+    init_tree_statistics(m);
+    init_linkage_disequilibrium(m);
+    init_haplotype_statistics(m);
+    init_association_scan(m);
+    init_ibd_segments(m);
     init_DataMatrixIterator(m);
 }
@@ -0,0 +1,62 @@
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpp/data_matrix.hpp>
+#include <fwdpy11/numpy/array.hpp>
+#include <core/ts/packed_genotype_matrix.hpp>
+#include <core/ts/linkage_disequilibrium.hpp>
+#include "packed_rows.hpp"
+
+namespace py = pybind11;
+
+namespace
+{
+    using fwdpy11_core::packed_data_matrix;
+    using fwdpy11_core::packed_genotype_matrix;
+
+    py::tuple
+    ld_tuple(packed_genotype_matrix rows,
+             fwdpy11_core::linkage_disequilibrium_pairs ld)
+    // (positions, keys, first, second, D, r2, Dprime)
+    {
+        return py::make_tuple(fwdpy11::make_1d_array_with_capsule(std::move(rows.positions)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(rows.keys)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(ld.first)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(ld.second)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(ld.D)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(ld.r2)),
+                              fwdpy11::make_1d_array_with_capsule(std::move(ld.Dprime)));
+    }
+
+    template <typename Matrix>
+    py::tuple
+    linkage_disequilibrium(const Matrix& m, bool neutral, bool selected,
+                           std::size_t max_sites_apart, double max_distance,
+                           std::size_t num_threads)
+    {
+        packed_genotype_matrix rows(fwdpy11_core::genotype_packing::haplotype, 0);
+        fwdpy11_core::linkage_disequilibrium_pairs ld;
+        {
+            py::gil_scoped_release release;
+            rows = packed_rows(m, neutral, selected);
+            ld = fwdpy11_core::linkage_disequilibrium(rows, max_sites_apart,
+                                                      max_distance, num_threads);
+        }
+        return ld_tuple(std::move(rows), std::move(ld));
+    }
+}
+
+void
+init_linkage_disequilibrium(py::module& m)
+{
+    m.def("_linkage_disequilibrium", &linkage_disequilibrium<packed_data_matrix>,
+          py::arg("matrix"), py::arg("neutral"), py::arg("selected"),
+          py::arg("max_sites_apart"), py::arg("max_distance"), py::arg("num_threads"));
+
+    m.def("_linkage_disequilibrium", &linkage_disequilibrium<fwdpp::data_matrix>,
+          py::arg("matrix"), py::arg("neutral"), py::arg("selected"),
+          py::arg("max_sites_apart"), py::arg("max_distance"), py::arg("num_threads"));
+}
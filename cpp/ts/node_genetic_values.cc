@@ -0,0 +1,385 @@
+#include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+#include <fwdpy11/genetic_values/DiploidAdditive.hpp>
+#include <fwdpy11/genetic_values/DiploidMultiplicative.hpp>
+#include <fwdpy11/genetic_values/DiploidMultivariateEffectsStrictAdditive.hpp>
+#include <fwdpy11/numpy/array.hpp>
+#include <core/ts/ancestral_mutation_sums.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    // Per-copy values and homozygote corrections for each
+    // included mutation row.  The columns are grouped by deme,
+    // with columns_per_deme columns per group.
+    struct mutation_columns
+    {
+        std::size_t columns_per_deme, ndemes;
+        std::vector<std::size_t> rows;
+        std::vector<double> values, hom_corrections;
+
+        mutation_columns(std::size_t k, std::size_t d)
+            : columns_per_deme(k), ndemes(d), rows{}, values{}, hom_corrections{}
+        {
+        }
+
+        std::size_t
+        ncols() const
+        {
+            return columns_per_deme * ndemes;
+        }
+    };
+
+    std::vector<std::size_t>
+    mutation_rows(const fwdpy11::DiploidPopulation& pop,
+                  const std::vector<std::size_t>& keys)
+    {
+        std::vector<char> included(pop.mutations.size(), 0);
+        for (auto k : keys)
+            {
+                if (k >= pop.mutations.size())
+                    {
+                        throw std::invalid_argument("mutation key is out of range");
+                    }
+                included[k] = 1;
+            }
+        std::vector<std::size_t> rows;
+        for (std::size_t i = 0; i < pop.tables->mutations.size(); ++i)
+            {
+                const auto key = pop.tables->mutations[i].key;
+                if (key < included.size() && included[key])
+                    {
+                        rows.push_back(i);
+                    }
+            }
+        return rows;
+    }
+
+    // Effect size and dominance of a mutation in a deme,
+    // matching the single and multi-deme policies of the
+    // stateless_site_dependent_genetic_value_wrapper.
+    std::pair<double, double>
+    effect_and_dominance(const fwdpy11::Mutation& m, std::size_t deme,
+                         std::size_t total_dim)
+    {
+        if (total_dim == 1)
+            {
+                return {m.s, m.h};
+            }
+        if (deme >= m.esizes.size() || deme >= m.heffects.size())
+            {
+                throw std::invalid_argument("deme index is out of range");
+            }
+        return {m.esizes[deme], m.heffects[deme]};
+    }
+
+    mutation_columns
+    additive_columns(const fwdpy11::DiploidPopulation& pop,
+                     const fwdpy11::DiploidAdditive& gvalue,
+                     const std::vector<std::size_t>& rows)
+    // One column per deme.  A heterozygote adds s*h and
+    // a homozygote adds scaling*s.
+    {
+        mutation_columns rv(1, gvalue.total_dim);
+        rv.rows = rows;
+        for (auto row : rows)
+            {
+                const auto& m = pop.mutations[pop.tables->mutations[row].key];
+                for (std::size_t d = 0; d < rv.ndemes; ++d)
+                    {
+                        auto eh = effect_and_dominance(m, d, gvalue.total_dim);
+                        rv.values.push_back(eh.first * eh.second);
+                        rv.hom_corrections.push_back(gvalue.scaling() * eh.first
+                                                     - 2.0 * eh.first * eh.second);
+                    }
+            }
+        return rv;
+    }
+
+    void
+    push_multiplicative_factor(double f, std::vector<double>& columns)
+    // The columns are the sum of log|f| over the nonzero factors,
+    // the number of negative factors and the number of zero factors.
+    {
+        columns.push_back(f == 0.0 ? 0.0 : std::log(std::fabs(f)));
+        columns.push_back(f < 0.0 ? 1.0 : 0.0);
+        columns.push_back(f == 0.0 ? 1.0 : 0.0);
+    }
+
+    mutation_columns
+    multiplicative_columns(const fwdpy11::DiploidPopulation& pop,
+                           const fwdpy11::DiploidMultiplicative& gvalue,
+                           const std::vector<std::size_t>& rows)
+    {
+        mutation_columns rv(3, gvalue.total_dim);
+        rv.rows = rows;
+        std::vector<double> het, hom;
+        for (auto row : rows)
+            {
+                const auto& m = pop.mutations[pop.tables->mutations[row].key];
+                for (std::size_t d = 0; d < rv.ndemes; ++d)
+                    {
+                        auto eh = effect_and_dominance(m, d, gvalue.total_dim);
+                        het.clear();
+                        hom.clear();
+                        push_multiplicative_factor(1. + eh.first * eh.second, het);
+                        push_multiplicative_factor(1. + gvalue.scaling() * eh.first,
+                                                   hom);
+                        for (std::size_t c = 0; c < 3; ++c)
+                            {
+                                rv.values.push_back(het[c]);
+                                rv.hom_corrections.push_back(hom[c] - 2.0 * het[c]);
+                            }
+                    }
+            }
+        return rv;
+    }
+
+    mutation_columns
+    multivariate_columns(const fwdpy11::DiploidPopulation& pop,
+                         const fwdpy11::DiploidMultivariateEffectsStrictAdditive& gvalue,
+                         const std::vector<std::size_t>& rows)
+    // One column per trait and no homozygote correction.
+    {
+        mutation_columns rv(gvalue.total_dim, 1);
+        rv.rows = rows;
+        for (auto row : rows)
+            {
+                const auto& m = pop.mutations[pop.tables->mutations[row].key];
+                if (m.esizes.size() != gvalue.total_dim)
+                    {
+                        throw std::invalid_argument(
+                            "dimensions of effect sizes do not match genetic value "
+                            "dimensions");
+                    }
+                rv.values.insert(end(rv.values), begin(m.esizes), end(m.esizes));
+            }
+        rv.hom_corrections.assign(rv.values.size(), 0.0);
+        return rv;
+    }
+
+    // Per-individual sums over both nodes, with each mutation
+    // carried by both nodes counted according to the homozygote policy.
+    std::vector<double>
+    individual_sums(const fwdpy11::DiploidPopulation& pop,
+                    const mutation_columns& columns,
+                    const std::vector<fwdpp::ts::table_index_t>& nodes,
+                    const std::vector<std::size_t>& slots)
+    {
+        const auto& tables = *pop.tables;
+        const std::size_t ncols = columns.ncols(), k = columns.columns_per_deme;
+        const std::size_t nind = slots.size();
+        for (auto u : nodes)
+            {
+                if (u < 0 || static_cast<std::size_t>(u) >= tables.nodes.size())
+                    {
+                        throw std::invalid_argument("node is out of range");
+                    }
+            }
+
+        std::vector<double> rv(nind * k, 0.0);
+        // y holds the homozygote corrections of the current tree.
+        std::vector<double> y(tables.nodes.size() * ncols, 0.0);
+        std::vector<fwdpp::ts::table_index_t> touched;
+        std::vector<std::size_t> stamp(tables.nodes.size(), 0);
+        std::size_t current_stamp = 0;
+        const auto on_tree = [&](const std::vector<fwdpp::ts::table_index_t>& parents,
+                                 const std::vector<std::size_t>& in_tree) {
+            touched.clear();
+            for (auto i : in_tree)
+                {
+                    const double* c = columns.hom_corrections.data() + i * ncols;
+                    if (std::none_of(c, c + ncols, [](double x) { return x != 0.0; }))
+                        {
+                            continue;
+                        }
+                    const auto u = tables.mutations[columns.rows[i]].node;
+                    touched.push_back(u);
+                    for (std::size_t j = 0; j < ncols; ++j)
+                        {
+                            y[u * ncols + j] += c[j];
+                        }
+                }
+            if (touched.empty())
+                {
+                    return;
+                }
+            for (std::size_t i = 0; i < nind; ++i)
+                {
+                    // Mutations above the MRCA of the two
+                    // nodes are carried by both of them.
+                    ++current_stamp;
+                    for (auto u = nodes[2 * i]; u != fwdpp::ts::NULL_INDEX;
+                         u = parents[u])
+                        {
+                            stamp[u] = current_stamp;
+                        }
+                    auto u = nodes[2 * i + 1];
+                    while (u != fwdpp::ts::NULL_INDEX && stamp[u] != current_stamp)
+                        {
+                            u = parents[u];
+                        }
+                    const double* yslot = y.data() + slots[i] * k;
+                    for (; u != fwdpp::ts::NULL_INDEX; u = parents[u])
+                        {
+                            for (std::size_t j = 0; j < k; ++j)
+                                {
+                                    rv[i * k + j] += yslot[u * ncols + j];
+                                }
+                        }
+                }
+            for (auto u : touched)
+                {
+                    std::fill(begin(y) + u * ncols, begin(y) + (u + 1) * ncols, 0.0);
+                }
+        };
+
+        std::vector<double> node_sums;
+        fwdpy11_core::accumulate_ancestral_mutation_sums(
+            tables, columns.rows, columns.values, ncols, node_sums, on_tree);
+        for (std::size_t i = 0; i < nind; ++i)
+            {
+                for (std::size_t n = 0; n < 2; ++n)
+                    {
+                        const double* s
+                            = node_sums.data() + nodes[2 * i + n] * ncols + slots[i] * k;
+                        for (std::size_t j = 0; j < k; ++j)
+                            {
+                                rv[i * k + j] += s[j];
+                            }
+                    }
+            }
+        return rv;
+    }
+
+    py::object
+    genetic_values_from_nodes(const fwdpy11::DiploidPopulation& pop,
+                              const fwdpy11::DiploidGeneticValue& gvalue,
+                              py::array_t<fwdpp::ts::table_index_t> nodes_array,
+                              const std::vector<std::size_t>& keys,
+                              const std::vector<std::size_t>& demes)
+    {
+        auto nodes_view = nodes_array.unchecked<2>();
+        if (nodes_view.shape(1) != 2)
+            {
+                throw std::invalid_argument("nodes must have two columns");
+            }
+        const std::size_t nind = nodes_view.shape(0);
+        std::vector<fwdpp::ts::table_index_t> nodes(2 * nind);
+        for (std::size_t i = 0; i < nind; ++i)
+            {
+                nodes[2 * i] = nodes_view(i, 0);
+                nodes[2 * i + 1] = nodes_view(i, 1);
+            }
+        if (!demes.empty() && demes.size() != nind)
+            {
+                throw std::invalid_argument(
+                    "length of demes does not match number of individuals");
+            }
+        if (gvalue.num_folded_fixations != pop.num_folded_fixations)
+            {
+                throw std::invalid_argument(
+                    "the fixation baseline of the genetic value object does not "
+                    "match the population");
+            }
+
+        const auto rows = mutation_rows(pop, keys);
+        const auto deme_slots = [&demes, nind](std::size_t total_dim) {
+            std::vector<std::size_t> slots(nind, 0);
+            if (total_dim > 1 && !demes.empty())
+                {
+                    for (std::size_t i = 0; i < nind; ++i)
+                        {
+                            if (demes[i] >= total_dim)
+                                {
+                                    throw std::invalid_argument(
+                                        "deme index is out of range");
+                                }
+                            slots[i] = demes[i];
+                        }
+                }
+            return slots;
+        };
+
+        if (auto additive = dynamic_cast<const fwdpy11::DiploidAdditive*>(&gvalue))
+            {
+                auto slots = deme_slots(additive->total_dim);
+                auto sums = individual_sums(pop, additive_columns(pop, *additive, rows),
+                                            nodes, slots);
+                for (std::size_t i = 0; i < nind; ++i)
+                    {
+                        double d = additive->fixation_baseline[slots[i]] + sums[i];
+                        sums[i] = additive->is_fitness() ? std::max(0.0, 1. + d) : d;
+                    }
+                return fwdpy11::make_1d_array_with_capsule(std::move(sums));
+            }
+        if (auto multiplicative
+            = dynamic_cast<const fwdpy11::DiploidMultiplicative*>(&gvalue))
+            {
+                auto slots = deme_slots(multiplicative->total_dim);
+                auto sums = individual_sums(
+                    pop, multiplicative_columns(pop, *multiplicative, rows), nodes,
+                    slots);
+                std::vector<double> rv(nind);
+                for (std::size_t i = 0; i < nind; ++i)
+                    {
+                        const double baseline
+                            = multiplicative->fixation_baseline[slots[i]];
+                        const auto nnegative = std::lround(sums[3 * i + 1]);
+                        const bool has_zero = std::lround(sums[3 * i + 2]) > 0;
+                        const double magnitude = baseline * std::exp(sums[3 * i]);
+                        if (multiplicative->is_fitness())
+                            {
+                                // The merge-walk returns 0 as soon as
+                                // the running product is <= 0.
+                                rv[i] = (baseline <= 0.0 || nnegative > 0 || has_zero)
+                                            ? 0.0
+                                            : magnitude;
+                            }
+                        else
+                            {
+                                double w = has_zero ? 0.0 : magnitude;
+                                if (nnegative % 2 != 0)
+                                    {
+                                        w = -w;
+                                    }
+                                rv[i] = w - 1.0;
+                            }
+                    }
+                return fwdpy11::make_1d_array_with_capsule(std::move(rv));
+            }
+        if (auto multivariate = dynamic_cast<
+                const fwdpy11::DiploidMultivariateEffectsStrictAdditive*>(&gvalue))
+            {
+                const std::size_t ndim = multivariate->total_dim;
+                auto sums = individual_sums(
+                    pop, multivariate_columns(pop, *multivariate, rows), nodes,
+                    std::vector<std::size_t>(nind, 0));
+                for (std::size_t i = 0; i < nind; ++i)
+                    {
+                        for (std::size_t j = 0; j < ndim; ++j)
+                            {
+                                sums[i * ndim + j] += multivariate->fixation_baseline[j];
+                            }
+                    }
+                return fwdpy11::make_2d_array_with_capsule(std::move(sums), nind, ndim);
+            }
+        throw std::invalid_argument(
+            "genetic values from nodes are only supported for Additive, "
+            "Multiplicative and additive multivariate effects models");
+    }
+}
+
+void
+init_node_genetic_values(py::module& m)
+{
+    m.def("_genetic_values_from_nodes", &genetic_values_from_nodes, py::arg("pop"),
+          py::arg("gvalue"), py::arg("nodes"), py::arg("keys"), py::arg("demes"));
+}
@@ -0,0 +1,211 @@
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/numpy/array.hpp>
+#include <core/ts/packed_genotype_matrix.hpp>
+#include <core/ts/windowed_data_matrices.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    using fwdpy11_core::packed_genotype_matrix;
+    using fwdpy11_core::packed_data_matrix;
+
+    std::string
+    packing_name(const packed_genotype_matrix& m)
+    {
+        return m.packing == fwdpy11_core::genotype_packing::haplotype ? "haplotype"
+                                                                      : "dosage";
+    }
+
+    packed_data_matrix
+    packed_data_matrix_from_tables(const fwdpp::ts::std_table_collection& tables,
+                                   const std::vector<fwdpp::ts::table_index_t>& samples,
+                                   bool record_neutral, bool record_selected,
+                                   bool include_fixations, double start, double stop,
+                                   const std::string& packing)
+    {
+        auto p = fwdpy11_core::genotype_packing_from_string(packing);
+        py::gil_scoped_release release;
+        return fwdpy11_core::packed_data_matrix_from_tables(
+            tables, samples, record_neutral, record_selected, include_fixations, start,
+            stop, p);
+    }
+
+    py::list
+    windowed_packed_data_matrices(
+        const fwdpp::ts::std_table_collection& tables,
+        const std::vector<fwdpp::ts::table_index_t>& samples,
+        const std::vector<std::pair<double, double>>& intervals, bool record_neutral,
+        bool record_selected, bool include_fixations, std::size_t num_threads,
+        const std::string& packing)
+    {
+        auto p = fwdpy11_core::genotype_packing_from_string(packing);
+        std::vector<packed_data_matrix> matrices;
+        {
+            py::gil_scoped_release release;
+            matrices.resize(intervals.size(), packed_data_matrix(p, samples.size()));
+            fwdpy11_core::windowed_data_matrices(
+                tables, samples, intervals, record_neutral, record_selected,
+                include_fixations, num_threads,
+                [&matrices, p](std::size_t window, fwdpp::data_matrix& dm) {
+                    // Each window has its own slot, so no locking is needed.
+                    matrices[window] = fwdpy11_core::pack_data_matrix(dm, p);
+                });
+        }
+        py::list rv;
+        for (auto& pdm : matrices)
+            {
+                rv.append(py::cast(std::move(pdm)));
+            }
+        return rv;
+    }
+}
+
+void
+init_packed_genotype_matrix(py::module& m)
+{
+    py::class_<packed_genotype_matrix>(m, "PackedGenotypeMatrix",
+                                       R"delim(
+    Bit-packed genotypes, with one row per variable site.
+
+    With ``"haplotype"`` packing, each sampled node occupies one bit.
+    With ``"dosage"`` packing, nodes ``2i`` and ``2i + 1`` of the
+    sample are individual ``i``, whose number of derived alleles
+    occupies two bits.
+    Entry ``j`` of a row starts at bit ``j * bits_per_entry`` of
+    the row, and rows are padded with zero bits to a whole
+    number of 64-bit words.
+
+    Instances are not constructed directly.
+    See :func:`fwdpy11.data_matrix_from_tables`.
+
+    .. versionadded:: 0.25.0
+    )delim")
+        .def_property_readonly("packing", &packing_name,
+                               "Either ``\"haplotype\"`` or ``\"dosage\"``")
+        .def_readonly("ncol", &packed_genotype_matrix::ncol,
+                      "Number of haplotypes or individuals")
+        .def_property_readonly(
+            "bits_per_entry",
+            [](const packed_genotype_matrix& self) { return self.bits_per_entry(); })
+        .def_property_readonly(
+            "data",
+            [](py::object self) {
+                const auto& m = self.cast<const packed_genotype_matrix&>();
+                return fwdpy11::make_2d_ndarray_readonly(m.data, m.nrow(),
+                                                         m.words_per_row, self);
+            },
+            "The packed rows as a 2d :class:`numpy.ndarray` of unsigned 64-bit "
+            "integers.  The data are not copied.")
+        .def_property_readonly(
+            "positions",
+            [](py::object self) {
+                const auto& m = self.cast<const packed_genotype_matrix&>();
+                return fwdpy11::make_1d_ndarray_readonly(m.positions, self);
+            },
+            "Position of each row")
+        .def_property_readonly(
+            "keys",
+            [](py::object self) {
+                const auto& m = self.cast<const packed_genotype_matrix&>();
+                return fwdpy11::make_1d_ndarray_readonly(m.keys, self);
+            },
+            "Mutation key of each row")
+        .def("__len__", &packed_genotype_matrix::nrow)
+        .def(
+            "unpack",
+            [](const packed_genotype_matrix& self) {
+                std::vector<std::int8_t> rv(self.nrow() * self.ncol);
+                {
+                    py::gil_scoped_release release;
+                    for (std::size_t r = 0; r < self.nrow(); ++r)
+                        {
+                            for (std::size_t c = 0; c < self.ncol; ++c)
+                                {
+                                    rv[r * self.ncol + c]
+                                        = static_cast<std::int8_t>(self.get(r, c));
+                                }
+                        }
+                }
+                return fwdpy11::make_2d_array_with_capsule(std::move(rv), self.nrow(),
+                                                           self.ncol);
+            },
+            R"delim(
+            :returns: The unpacked genotypes, with one row per site.
+            :rtype: numpy.ndarray
+            )delim")
+        .def(
+            "allele_counts",
+            [](const packed_genotype_matrix& self) {
+                std::vector<std::uint32_t> rv;
+                {
+                    py::gil_scoped_release release;
+                    rv = fwdpy11_core::allele_counts(self);
+                }
+                return fwdpy11::make_1d_array_with_capsule(std::move(rv));
+            },
+            R"delim(
+            :returns: The number of derived alleles at each site.
+            :rtype: numpy.ndarray
+            )delim")
+        .def(
+            "heterozygous_sites",
+            [](const packed_genotype_matrix& self) {
+                std::vector<std::uint32_t> rv;
+                {
+                    py::gil_scoped_release release;
+                    rv = fwdpy11_core::heterozygous_sites(self);
+                }
+                return fwdpy11::make_1d_array_with_capsule(std::move(rv));
+            },
+            R"delim(
+            :returns: The number of heterozygous sites in each individual.
+            :rtype: numpy.ndarray
+
+            For haplotype packing, columns ``2i`` and ``2i + 1`` are
+            the two genomes of individual ``i``.
+            )delim")
+        .def(
+            "pairwise_differences",
+            [](const packed_genotype_matrix& self) {
+                std::vector<std::uint32_t> rv;
+                {
+                    py::gil_scoped_release release;
+                    rv = fwdpy11_core::pairwise_differences(self);
+                }
+                return fwdpy11::make_2d_array_with_capsule(std::move(rv), self.ncol,
+                                                           self.ncol);
+            },
+            R"delim(
+            :returns: The number of differences between each pair of columns.
+            :rtype: numpy.ndarray
+
+            For dosage packing, each site contributes the absolute
+            difference in the number of derived alleles.
+            )delim");
+
+    py::class_<packed_data_matrix>(m, "PackedDataMatrix",
+                                   R"delim(
+    Bit-packed neutral and selected genotypes.
+    Each is a :class:`fwdpy11.PackedGenotypeMatrix`.
+
+    .. versionadded:: 0.25.0
+    )delim")
+        .def_readonly("neutral", &packed_data_matrix::neutral)
+        .def_readonly("selected", &packed_data_matrix::selected);
+
+    m.def("_packed_data_matrix_from_tables", &packed_data_matrix_from_tables,
+          py::arg("tables"), py::arg("samples"), py::arg("record_neutral"),
+          py::arg("record_selected"), py::arg("include_fixations"), py::arg("begin"),
+          py::arg("end"), py::arg("packing"));
+
+    m.def("_windowed_packed_data_matrices", &windowed_packed_data_matrices,
+          py::arg("tables"), py::arg("samples"), py::arg("intervals"),
+          py::arg("record_neutral"), py::arg("record_selected"),
+          py::arg("include_fixations"), py::arg("num_threads"), py::arg("packing"));
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <stdexcept>
+#include <fwdpp/data_matrix.hpp>
+#include <core/ts/packed_genotype_matrix.hpp>
+
+// Neutral rows, selected rows, or both in order of position.
+inline fwdpy11_core::packed_genotype_matrix
+packed_rows(const fwdpy11_core::packed_data_matrix& m, bool neutral, bool selected)
+{
+    if (neutral && selected)
+        {
+            return fwdpy11_core::merge_by_position(m.neutral, m.selected);
+        }
+    if (neutral)
+        {
+            return m.neutral;
+        }
+    if (selected)
+        {
+            return m.selected;
+        }
+    throw std::invalid_argument("at least one of neutral or selected must be True");
+}
+
+inline fwdpy11_core::packed_genotype_matrix
+packed_rows(const fwdpp::data_matrix& dm, bool neutral, bool selected)
+{
+    return packed_rows(
+        fwdpy11_core::pack_data_matrix(dm, fwdpy11_core::genotype_packing::haplotype),
+        neutral, selected);
+}
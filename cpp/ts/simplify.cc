@@ -3,15 +3,33 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 #include <pybind11/stl.h>
-#include <fwdpp/ts/table_simplifier.hpp>
+#include <core/ts/partitioned_simplification.hpp>
 
 namespace py = pybind11;
 
 PYBIND11_MAKE_OPAQUE(std::vector<fwdpy11::Mutation>);
 
+namespace
+{
+    std::vector<fwdpp::ts::table_index_t>
+    simplify_copy(fwdpp::ts::std_table_collection& t,
+                  const std::vector<fwdpp::ts::table_index_t>& samples,
+                  std::size_t num_threads)
+    {
+        if (num_threads == 0)
+            {
+                throw std::invalid_argument("num_threads must be > 0");
+            }
+        py::gil_scoped_release release;
+        auto rv = partitioned_simplification(samples, num_threads, t);
+        t.build_indexes();
+        return std::move(rv.first);
+    }
+}
+
 py::tuple
 simplify(const fwdpy11::DiploidPopulation& pop,
-         const std::vector<fwdpp::ts::table_index_t>& samples)
+         const std::vector<fwdpp::ts::table_index_t>& samples, std::size_t num_threads)
 {
     if (pop.tables->genome_length() == std::numeric_limits<double>::max())
         {
@@ -34,29 +52,27 @@ simplify(const fwdpy11::DiploidPopulation& pop,
             throw std::invalid_argument("invalid sample list");
         }
     auto t(*pop.tables);
-    fwdpp::ts::table_simplifier<fwdpp::ts::std_table_collection> simplifier{};
-    auto rv = simplifier.simplify(t, samples);
-    t.build_indexes();
+    auto idmap = simplify_copy(t, samples, num_threads);
     return py::make_tuple(std::move(t),
-                          fwdpy11::make_1d_array_with_capsule(std::move(rv.first)));
+                          fwdpy11::make_1d_array_with_capsule(std::move(idmap)));
 }
 
 void
 init_simplify_functions(py::module& m)
 {
-    m.def("_simplify", &simplify, py::arg("pop"), py::arg("samples"));
+    m.def("_simplify", &simplify, py::arg("pop"), py::arg("samples"),
+          py::arg("num_threads") = 1);
 
     m.def(
         "_simplify_tables",
         [](const fwdpp::ts::std_table_collection& tables,
-           const std::vector<fwdpp::ts::table_index_t>& samples) -> py::tuple {
+           const std::vector<fwdpp::ts::table_index_t>& samples,
+           std::size_t num_threads) -> py::tuple {
             auto t(tables);
-            fwdpp::ts::table_simplifier<fwdpp::ts::std_table_collection> simplifier{};
-            auto rv = simplifier.simplify(t, samples);
-            t.build_indexes();
-            return py::make_tuple(
-                std::move(t), fwdpy11::make_1d_array_with_capsule(std::move(rv.first)));
+            auto idmap = simplify_copy(t, samples, num_threads);
+            return py::make_tuple(std::move(t),
+                                  fwdpy11::make_1d_array_with_capsule(std::move(idmap)));
         },
-        py::arg("tables"), py::arg("samples"));
+        py::arg("tables"), py::arg("samples"), py::arg("num_threads") = 1);
 }
 
@@ -0,0 +1,79 @@
+#include <string>
+#include <utility>
+#include <vector>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <fwdpy11/numpy/array.hpp>
+#include <core/ts/tree_statistics.hpp>
+
+namespace py = pybind11;
+
+namespace
+{
+    fwdpy11_core::statistic_mode
+    mode_from_string(const std::string& mode)
+    {
+        if (mode == "site")
+            {
+                return fwdpy11_core::statistic_mode::site;
+            }
+        if (mode == "branch")
+            {
+                return fwdpy11_core::statistic_mode::branch;
+            }
+        throw std::invalid_argument("mode must be \"site\" or \"branch\"");
+    }
+
+    py::array_t<double>
+    tree_statistic(const fwdpp::ts::std_table_collection& tables,
+                   const std::vector<std::vector<fwdpp::ts::table_index_t>>& sample_sets,
+                   const std::vector<double>& windows, const std::string& statistic,
+                   const std::string& mode, bool polarised, bool span_normalise,
+                   bool include_neutral, bool include_selected,
+                   const std::vector<std::pair<std::size_t, std::size_t>>& indexes)
+    {
+        const fwdpy11_core::tree_statistic_options options{
+            mode_from_string(mode), polarised, span_normalise, include_neutral,
+            include_selected};
+        std::vector<double> rv;
+        {
+            py::gil_scoped_release release;
+            if (statistic == "diversity")
+                {
+                    rv = fwdpy11_core::diversity(tables, sample_sets, windows, options);
+                }
+            else if (statistic == "divergence")
+                {
+                    rv = fwdpy11_core::divergence(tables, sample_sets, indexes, windows,
+                                                  options);
+                }
+            else if (statistic == "segregating_sites")
+                {
+                    rv = fwdpy11_core::segregating_sites(tables, sample_sets, windows,
+                                                         options);
+                }
+            else if (statistic == "allele_frequency_spectrum")
+                {
+                    rv = fwdpy11_core::allele_frequency_spectrum(tables, sample_sets,
+                                                                 windows, options);
+                }
+            else
+                {
+                    throw std::invalid_argument("unknown statistic: " + statistic);
+                }
+        }
+        const auto nwindows = windows.size() - 1;
+        const auto dim = rv.size() / nwindows;
+        return fwdpy11::make_2d_array_with_capsule(std::move(rv), nwindows, dim);
+    }
+}
+
+void
+init_tree_statistics(py::module& m)
+{
+    m.def("_tree_statistic", &tree_statistic, py::arg("tables"), py::arg("sample_sets"),
+          py::arg("windows"), py::arg("statistic"), py::arg("mode"),
+          py::arg("polarised"), py::arg("span_normalise"), py::arg("include_neutral"),
+          py::arg("include_selected"), py::arg("indexes"));
+}
@@ -121,6 +121,45 @@ struct common_setup_with_sample_history_recording : public common_setup<T>
     }
 };
 
+template <typename T> struct common_setup_with_preserved_node_checks : public common_setup<T>
+// Records ancient samples every generation and checks that the
+// incrementally updated preserved nodes match a full rebuild.
+{
+    unsigned num_checks;
+    common_setup_with_preserved_node_checks() : common_setup<T>(), num_checks{0}
+    {
+        this->sample_recorder_callback
+            = [](const fwdpy11::DiploidPopulation& pop, fwdpy11::SampleRecorder& sr) {
+                  sr.add_sample(pop.generation % pop.N);
+                  sr.add_sample((3 * pop.generation + 1) % pop.N);
+              };
+        this->stopping_criterion
+            = [this](const fwdpy11::DiploidPopulation&, const bool) -> bool {
+            check_preserved_nodes();
+            return false;
+        };
+    }
+
+    void
+    check_preserved_nodes()
+    {
+        std::vector<fwdpp::ts::table_index_t> expected;
+        for (auto& md : this->pop.ancient_sample_metadata)
+            {
+                for (auto i : md.nodes)
+                    {
+                        if (std::find(begin(expected), end(expected), i) == end(expected))
+                            {
+                                expected.push_back(i);
+                            }
+                    }
+            }
+        this->pop.fill_preserved_nodes();
+        BOOST_REQUIRE(this->pop.preserved_sample_nodes == expected);
+        ++num_checks;
+    }
+};
+
 struct ancestry_proportions
 {
     std::uint32_t generation;
@@ -688,4 +727,41 @@ BOOST_FIXTURE_TEST_CASE(test_no_residual_selfing_exception, common_setup<DemeSiz
         fwdpy11::discrete_demography::DemographyError);
 }
 
+BOOST_FIXTURE_TEST_CASE(
+    test_preserved_node_index,
+    common_setup_with_preserved_node_checks<SingleDemeModelOneSizeChange>)
+{
+    auto model = build_model();
+    fwdpy11_core::ForwardDemesGraph forward_demes_graph(model.yaml, 10);
+    // Several simplifications, with ancient samples
+    // recorded between each of them.
+    evolve_with_tree_sequences(rng, pop, recorder, 7, forward_demes_graph, 60, 0., 0.,
+                               mregions, recregions, gvalue_ptrs,
+                               sample_recorder_callback, stopping_criterion,
+                               post_simplification_recorder, options);
+    BOOST_REQUIRE_EQUAL(num_checks, 60);
+    BOOST_REQUIRE(!pop.ancient_sample_metadata.empty());
+    // Outside of a simulation, the nodes are rebuilt from scratch.
+    check_preserved_nodes();
+}
+
+BOOST_FIXTURE_TEST_CASE(
+    test_preserved_node_index_with_resetting_of_tree_sequences,
+    common_setup_with_preserved_node_checks<SingleDemeModelOneSizeChange>)
+{
+    auto model = build_model();
+    fwdpy11_core::ForwardDemesGraph forward_demes_graph(model.yaml, 10);
+    options.reset_treeseqs_to_alive_nodes_after_simplification = true;
+    unsigned num_resets = 0;
+    post_simplification_recorder
+        = [&num_resets](const fwdpy11::DiploidPopulation&) { ++num_resets; };
+    evolve_with_tree_sequences(rng, pop, recorder, 7, forward_demes_graph, 60, 0., 0.,
+                               mregions, recregions, gvalue_ptrs,
+                               sample_recorder_callback, stopping_criterion,
+                               post_simplification_recorder, options);
+    BOOST_REQUIRE(num_resets > 1);
+    BOOST_REQUIRE_EQUAL(num_checks, 60);
+    check_preserved_nodes();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,59 @@
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <fwdpy11/genetic_values/multivariate_kernels.hpp>
+
+BOOST_AUTO_TEST_SUITE(test_multivariate_kernels)
+
+BOOST_AUTO_TEST_CASE(test_accumulate_effect_rows)
+// Covers the specialised dimensions and the generic fallback
+{
+    for (std::size_t ndim = 1; ndim < 12; ++ndim)
+        {
+            std::vector<double> effects(5 * ndim);
+            for (std::size_t i = 0; i < effects.size(); ++i)
+                {
+                    effects[i] = static_cast<double>(i);
+                }
+            std::vector<std::uint32_t> keys{0, 2, 4, 2};
+            std::vector<double> output(ndim, 1.0);
+            fwdpy11::accumulate_effect_rows(effects.data(), ndim, keys.data(),
+                                                 keys.size(), output.data());
+            for (std::size_t j = 0; j < ndim; ++j)
+                {
+                    double expected = 1.0;
+                    for (auto k : keys)
+                        {
+                            expected += effects[k * ndim + j];
+                        }
+                    BOOST_REQUIRE_EQUAL(output[j], expected);
+                }
+        }
+}
+
+BOOST_AUTO_TEST_CASE(test_multivariate_gaussian_fitness)
+{
+    for (std::size_t ndim = 1; ndim < 12; ++ndim)
+        {
+            std::vector<double> gvalues(3 * ndim);
+            for (std::size_t i = 0; i < gvalues.size(); ++i)
+                {
+                    gvalues[i] = 0.1 * static_cast<double>(i);
+                }
+            std::vector<double> optima(ndim, 0.5), fitness(3);
+            fwdpy11::multivariate_gaussian_fitness(
+                gvalues.data(), 3, ndim, optima.data(), 2.0, fitness.data());
+            for (std::size_t i = 0; i < 3; ++i)
+                {
+                    double d = 0.0;
+                    for (std::size_t j = 0; j < ndim; ++j)
+                        {
+                            d += std::pow(gvalues[i * ndim + j] - optima[j], 2.0);
+                        }
+                    BOOST_REQUIRE_CLOSE(fitness[i], std::exp(-d / 4.0), 1e-8);
+                }
+        }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
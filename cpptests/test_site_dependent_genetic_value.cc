@@ -9,6 +9,7 @@
 #include <boost/test/unit_test_suite.hpp>
 #include <fwdpy11/genetic_values/DiploidMultiplicative.hpp>
 #include <fwdpy11/genetic_values/DiploidAdditive.hpp>
+#include <fwdpy11/genetic_value_to_fitness/GSSmo.hpp>
 
 struct Mutation : public fwdpp::mutation_base
 {
@@ -144,6 +145,24 @@ BOOST_FIXTURE_TEST_CASE(test_additive_fitness, Pop)
     BOOST_REQUIRE(gv > 0.0);
 }
 
+BOOST_FIXTURE_TEST_CASE(test_exceptions_from_policies_propagate, Pop)
+{
+    // Multi-deme policies throw when a deme index is out of range.
+    mutations.emplace_back(1.0, -0.1, 1.0);
+    genomes.emplace_back(1);
+    genomes.emplace_back(1);
+    genomes[0].smutations.emplace_back(0);
+    fwdpy11::site_dependent_genetic_value sdgv{[](const double) { return false; }};
+    const auto throwing_policy = [](double &, const auto &) {
+        throw std::invalid_argument("deme index is out of range");
+    };
+    BOOST_REQUIRE_THROW(
+        sdgv(genomes[0].smutations.begin(), genomes[0].smutations.end(),
+             genomes[1].smutations.begin(), genomes[1].smutations.end(), mutations,
+             throwing_policy, throwing_policy, 1.0),
+        std::invalid_argument);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 // NOTE: the tests below rely on knowledge of how
@@ -208,4 +227,119 @@ BOOST_FIXTURE_TEST_CASE(test_multiplicative_fitness_1, Fwdpy11Pop)
     BOOST_REQUIRE_EQUAL(offspring_metadata[0].w, 0.);
 }
 
+BOOST_FIXTURE_TEST_CASE(test_multiplicative_fitness_batch, Fwdpy11Pop)
+{
+    pop.mutations.emplace_back(false, 0.1, -1.55, 1.0, 0);
+    pop.mutations.emplace_back(false, 0.2, -1.55, 1.0, 0);
+    pop.haploid_genomes[0].smutations.emplace_back(0);
+    pop.haploid_genomes[0].smutations.emplace_back(1);
+    pop.haploid_genomes.emplace_back(1);
+    pop.diploids[0] = {0, 1};
+    offspring_metadata.emplace_back(
+        fwdpy11::DiploidMetadata{0., 0., 1., {0., 0., 0.}, 0, {0, 0}, 0, 0, {0, 0}});
+    fwdpy11::GSLrng_t rng(42);
+    std::vector<double> batch;
+
+    // User-defined policies do not have a batch kernel
+    fwdpy11::DiploidMultiplicative custom(
+        1, 2., fwdpy11::final_multiplicative_fitness(),
+        [](const double) { return false; }, nullptr, nullptr);
+    BOOST_REQUIRE(!custom.calculate_gvalues(rng, pop, offspring_metadata, {0}, batch));
+
+    auto m = fwdpy11::multiplicative_fitness_model(1, 2., nullptr);
+    BOOST_REQUIRE(m.calculate_gvalues(rng, pop, offspring_metadata, {0}, batch));
+    BOOST_REQUIRE_EQUAL(batch.size(), 1);
+    BOOST_REQUIRE_EQUAL(batch[0], 0.);
+
+    fwdpy11::GSSmo gss({fwdpy11::Optimum(0, 0., 1.)});
+    auto t = fwdpy11::multiplicative_trait_model(1, 2., &gss, nullptr);
+    fwdpy11::DiploidGeneticValueData data{rng,
+                                          pop,
+                                          pop.diploid_metadata[0],
+                                          pop.diploid_metadata[0],
+                                          0,
+                                          offspring_metadata[0]};
+    t(data);
+    BOOST_REQUIRE(t.calculate_gvalues(rng, pop, offspring_metadata, {0}, batch));
+    BOOST_REQUIRE_EQUAL(batch[0], offspring_metadata[0].g);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_fold_fixation, Fwdpy11Pop)
+{
+    // Mutation 0 is homozygous, so removing it from both genomes
+    // after folding it into the baseline must not change genetic values.
+    pop.mutations.emplace_back(false, 0.1, -0.25, 0.5, 0);
+    pop.mutations.emplace_back(false, 0.2, 0.1, 0.5, 0);
+    pop.haploid_genomes[0].smutations.emplace_back(0);
+    pop.haploid_genomes[0].smutations.emplace_back(1);
+    pop.haploid_genomes.emplace_back(1);
+    pop.haploid_genomes[1].smutations.emplace_back(0);
+    pop.diploids[0] = {0, 1};
+    offspring_metadata.emplace_back(
+        fwdpy11::DiploidMetadata{0., 0., 1., {0., 0., 0.}, 0, {0, 0}, 0, 0, {0, 0}});
+    fwdpy11::GSLrng_t rng(42);
+    std::vector<double> batch;
+
+    auto additive = fwdpy11::additive_fitness_model(1, 2., nullptr);
+    auto multiplicative = fwdpy11::multiplicative_fitness_model(1, 2., nullptr);
+    BOOST_REQUIRE(additive.can_fold_fixations());
+    BOOST_REQUIRE_EQUAL(additive.fixation_baseline.size(), 1);
+    BOOST_REQUIRE_EQUAL(additive.fixation_baseline[0], 0.);
+    BOOST_REQUIRE_EQUAL(multiplicative.fixation_baseline[0], 1.);
+
+    fwdpy11::DiploidGeneticValueData data{rng,
+                                          pop,
+                                          pop.diploid_metadata[0],
+                                          pop.diploid_metadata[0],
+                                          0,
+                                          offspring_metadata[0]};
+    additive(data);
+    const auto additive_w = offspring_metadata[0].w;
+    multiplicative(data);
+    const auto multiplicative_w = offspring_metadata[0].w;
+
+    additive.fold_fixation(pop.mutations[0]);
+    multiplicative.fold_fixation(pop.mutations[0]);
+    BOOST_CHECK_CLOSE(additive.fixation_baseline[0], -0.5, 1e-8);
+    BOOST_CHECK_CLOSE(multiplicative.fixation_baseline[0], 0.5, 1e-8);
+    pop.haploid_genomes[0].smutations.erase(pop.haploid_genomes[0].smutations.begin());
+    pop.haploid_genomes[1].smutations.clear();
+
+    additive(data);
+    BOOST_CHECK_CLOSE(offspring_metadata[0].w, additive_w, 1e-8);
+    BOOST_REQUIRE(additive.calculate_gvalues(rng, pop, offspring_metadata, {0}, batch));
+    BOOST_CHECK_CLOSE(batch[0], additive_w, 1e-8);
+    multiplicative(data);
+    BOOST_CHECK_CLOSE(offspring_metadata[0].w, multiplicative_w, 1e-8);
+    BOOST_REQUIRE(
+        multiplicative.calculate_gvalues(rng, pop, offspring_metadata, {0}, batch));
+    BOOST_CHECK_CLOSE(batch[0], multiplicative_w, 1e-8);
+}
+
+BOOST_FIXTURE_TEST_CASE(test_compact_mutation_table, Fwdpy11Pop)
+{
+    pop.mutations.emplace_back(false, 0.1, -0.25, 0.5, 0);
+    pop.mutations.emplace_back(false, 0.2, 0.1, 0.25, 0);
+    pop.mutations.emplace_back(false, 0.3, 0.3, 1.0, 0);
+    pop.haploid_genomes[0].smutations = {0, 1, 2};
+    pop.haploid_genomes.emplace_back(1);
+    pop.haploid_genomes[1].smutations = {1};
+    std::vector<fwdpy11::compact_mutation> table;
+    fwdpy11::fill_compact_mutation_table(pop.mutations, table);
+    BOOST_REQUIRE_EQUAL(table.size(), pop.mutations.size());
+    const auto &g1 = pop.haploid_genomes[0].smutations;
+    const auto &g2 = pop.haploid_genomes[1].smutations;
+    const auto rv = [](double d) { return d; };
+    auto expected = fwdpy11::site_dependent_genetic_value_kernel(
+        g1.cbegin(), g1.cend(), g2.cbegin(), g2.cend(), pop.mutations,
+        fwdpy11::single_deme_additive_hom(2.), fwdpy11::single_deme_additive_het(), rv,
+        fwdpy11::never_clamp(), 0.);
+    auto compact = fwdpy11::site_dependent_genetic_value_kernel(
+        g1.cbegin(), g1.cend(), g2.cbegin(), g2.cend(), table,
+        fwdpy11::single_deme_additive_hom(2.), fwdpy11::single_deme_additive_het(), rv,
+        fwdpy11::never_clamp(), 0.);
+    BOOST_REQUIRE_EQUAL(expected, compact);
+    BOOST_CHECK_CLOSE(compact, -0.25 * 0.5 + 2. * 0.1 + 0.3, 1e-8);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,158 @@
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include <boost/test/unit_test.hpp>
+#include <evolve_discrete_demes/squash_breakpoints.hpp>
+
+namespace
+{
+    constexpr double END = std::numeric_limits<double>::max();
+
+    using segment = std::tuple<double, double, fwdpp::ts::table_index_t>;
+
+    std::vector<segment>
+    inherited_segments(
+        const std::vector<double>& breakpoints,
+        std::pair<fwdpp::ts::table_index_t, fwdpp::ts::table_index_t> nodes,
+        double genome_length, bool merge)
+    // The parental node of each segment of [0, genome_length),
+    // switching nodes at every breakpoint.  This is the
+    // reference for the edges recorded for an offspring node.
+    {
+        std::vector<segment> rv;
+        double left = 0.0;
+        for (auto b : breakpoints)
+            {
+                const auto right = std::min(b, genome_length);
+                if (merge && right == left)
+                    {
+                        std::swap(nodes.first, nodes.second);
+                        continue;
+                    }
+                if (merge && !rv.empty() && std::get<2>(rv.back()) == nodes.first)
+                    {
+                        std::get<1>(rv.back()) = right;
+                    }
+                else
+                    {
+                        rv.emplace_back(left, right, nodes.first);
+                    }
+                std::swap(nodes.first, nodes.second);
+                left = right;
+            }
+        return rv;
+    }
+
+    struct squash_fixture
+    {
+        std::pair<fwdpp::ts::table_index_t, fwdpp::ts::table_index_t> nodes;
+        squash_fixture() : nodes{1, 2}
+        {
+        }
+    };
+}
+
+BOOST_FIXTURE_TEST_SUITE(test_squash_breakpoints, squash_fixture)
+
+BOOST_AUTO_TEST_CASE(test_no_breakpoints)
+{
+    std::vector<double> b;
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b.empty());
+    b = {END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({END}));
+    BOOST_REQUIRE_EQUAL(nodes.first, 1);
+    BOOST_REQUIRE_EQUAL(nodes.second, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_distinct_breakpoints_are_unchanged)
+{
+    std::vector<double> b{0.5, 2., 3., END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({0.5, 2., 3., END}));
+    BOOST_REQUIRE_EQUAL(nodes.first, 1);
+    BOOST_REQUIRE_EQUAL(nodes.second, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_duplicates_cancel_in_pairs)
+{
+    std::vector<double> b{1., 1., END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({END}));
+
+    b = {1., 1., 1., END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({1., END}));
+
+    // Cancellation exposes neighbours that are not duplicates.
+    b = {1., 2., 2., 3., 3., 3., 3., 4., END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({1., 4., END}));
+    BOOST_REQUIRE_EQUAL(nodes.first, 1);
+    BOOST_REQUIRE_EQUAL(nodes.second, 2);
+}
+
+BOOST_AUTO_TEST_CASE(test_leading_zero_swaps_parental_nodes)
+{
+    std::vector<double> b{0., 2., END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({2., END}));
+    BOOST_REQUIRE_EQUAL(nodes.first, 2);
+    BOOST_REQUIRE_EQUAL(nodes.second, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_cancelled_leading_zeros_do_not_swap)
+{
+    std::vector<double> b{0., 0., 2., END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({2., END}));
+    BOOST_REQUIRE_EQUAL(nodes.first, 1);
+    BOOST_REQUIRE_EQUAL(nodes.second, 2);
+
+    b = {0., 0., 0., 1., 1., END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({END}));
+    BOOST_REQUIRE_EQUAL(nodes.first, 2);
+    BOOST_REQUIRE_EQUAL(nodes.second, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_sentinel_is_kept)
+{
+    // The sentinel never cancels, even if duplicated.
+    std::vector<double> b{3., END, END};
+    squash_breakpoints(b, nodes);
+    BOOST_REQUIRE(b == std::vector<double>({3., END, END}));
+}
+
+BOOST_AUTO_TEST_CASE(test_segments_match_unsquashed_breakpoints)
+{
+    // Crossovers at integer positions give many duplicates
+    // and zeros.  The segments recorded after squashing
+    // must be those of the unsquashed breakpoints with
+    // zero-length segments removed and adjacent segments
+    // from the same node merged.
+    constexpr double L = 5.0;
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> position(0, static_cast<int>(L) - 1);
+    std::uniform_int_distribution<int> count(0, 8);
+    for (int replicate = 0; replicate < 1000; ++replicate)
+        {
+            std::vector<double> b(count(generator));
+            for (auto& x : b)
+                {
+                    x = position(generator);
+                }
+            std::sort(begin(b), end(b));
+            b.push_back(END);
+            const auto expected = inherited_segments(b, nodes, L, true);
+            auto squashed_nodes = nodes;
+            squash_breakpoints(b, squashed_nodes);
+            BOOST_REQUIRE(inherited_segments(b, squashed_nodes, L, false) == expected);
+        }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
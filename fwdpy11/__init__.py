@@ -56,6 +56,8 @@ from .genetic_values import (  # NOQA
     GBR,
     AdditivePleiotropy,
     PyDiploidGeneticValue,
+    CFunctionGeneticValue,
+    CFunctionGeneticValueToFitnessMap,
     TimingError,
 )
 
@@ -66,6 +68,7 @@ from ._types import (  # NOQA
     DiploidPopulation,
     TreeIterator,
     VariantIterator,
+    VariantChunk,
     NewMutationData,
     ForwardTimeInterval,
     ForwardDemesGraph,
@@ -77,6 +80,7 @@ from ._types.model_params import ModelParams, MutationAndRecombinationRates  # N
 from ._evolvets import *  # NOQA
 
 from ._functions import (  # NOQA
+    data_matrices_from_tables,
     data_matrix_from_tables,
     infinite_sites,
     simplify_tables,
@@ -40,6 +40,7 @@ def evolvets(
     track_mutation_counts: Optional[bool] = None,
     remove_extinct_variants: Optional[bool] = None,
     preserve_first_generation: Optional[bool] = None,
+    fold_selected_fixations: Optional[bool] = None,
 ):
     """
     Evolve a population with tree sequence recording
@@ -73,6 +74,12 @@ def evolvets(
                                       A value of `None` will be treated
                                       as `False`.
     :type preserve_first_generation: Optional[bool]
+    :param fold_selected_fixations: (None) Whether to remove selected fixations
+                                    from genomes after adding their effects to
+                                    :attr:`fwdpy11.DiploidGeneticValue.fixation_baseline`.
+                                    A value of `None` will be treated
+                                    as `False`.
+    :type fold_selected_fixations: Optional[bool]
 
     The recording of genetic values into :attr:`fwdpy11.DiploidPopulation.genetic_values`
     is suppressed by default.  First, it is redundant with
@@ -114,6 +121,23 @@ def evolvets(
           input model is `None`.
         * Remove option `check_demographic_event_timings`
 
+    .. versionchanged:: 0.25.0
+
+        Added ``fold_selected_fixations``.
+        When ``True``, selected fixations are pruned from genomes
+        as if ``prune_selected`` were ``True``, but genetic values
+        are unchanged because the homozygous effect of each fixation
+        is stored in the genetic value object.
+        Fixations are also removed from the mutation table.
+        Only :class:`fwdpy11.Additive`, :class:`fwdpy11.Multiplicative`,
+        and :class:`fwdpy11.AdditivePleiotropy` support this option.
+        The population records how many fixations have been folded.
+        If that number is zero, the baseline is reset when the
+        simulation starts, so that a parameter object may be reused
+        for independent replicates.  Otherwise, the genetic value
+        object must be the one that the fixations were folded into,
+        and :class:`ValueError` is raised if it is not.
+
     """
     if params.demography is not None:
         try:
@@ -304,6 +328,10 @@ def evolvets(
         options.preserve_first_generation = preserve_first_generation
     else:
         options.preserve_first_generation = False
+    if fold_selected_fixations is not None:
+        options.fold_selected_fixations = fold_selected_fixations
+    else:
+        options.fold_selected_fixations = False
     options.allow_residual_selfing = params.allow_residual_selfing
 
     if options.allow_residual_selfing is False:
@@ -1,4 +1,7 @@
-from .data_matrix_from_tables import data_matrix_from_tables  # NOQA
+from .data_matrix_from_tables import (  # NOQA
+    data_matrices_from_tables,
+    data_matrix_from_tables,
+)
 from .import_demes import demography_from_demes  # NOQa
 from .simplify_tables import simplify_tables  # NOQA
 
@@ -17,11 +17,17 @@
 # along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
 #
 
-from typing import List, Optional, Union
+from typing import List, Optional, Tuple, Union
 
 import numpy as np
 
-from .._fwdpy11 import _data_matrix_from_tables
+from .._fwdpy11 import (
+    PackedDataMatrix,
+    _data_matrix_from_tables,
+    _packed_data_matrix_from_tables,
+    _windowed_data_matrices,
+    _windowed_packed_data_matrices,
+)
 from .._types import DataMatrix, TableCollection
 
 
@@ -34,7 +40,8 @@ def data_matrix_from_tables(
     include_fixations: bool = False,
     begin: float = 0.0,
     end: Optional[float] = None,
-) -> DataMatrix:
+    packing: Optional[str] = None,
+) -> Union[DataMatrix, PackedDataMatrix]:
     """
     Create a :class:`fwdpy11.DataMatrix` from a table collection.
 
@@ -50,8 +57,15 @@ def data_matrix_from_tables(
     :type include_selected: bool
     :param begin: (0.0) Start of range, inclusive
     :param end: (max float) End of range, exclusive
+    :param packing: (None) Either ``"haplotype"`` or ``"dosage"``
+    :type packing: str
 
-    :rtype: :class:`fwdpy11.DataMatrix`
+    :rtype: :class:`fwdpy11.DataMatrix` or :class:`fwdpy11.PackedDataMatrix`
+
+    If `packing` is not None, a :class:`fwdpy11.PackedDataMatrix`
+    is returned.  Each site is packed as it is generated, so the
+    unpacked matrix is never held in memory.
+    Dosage packing requires an even number of samples.
 
     .. versionadded:: 0.3.0
 
@@ -63,12 +77,27 @@ def data_matrix_from_tables(
 
            No longer requires :class:`fwdpy11.MutationVector` argument
 
+    .. versionchanged:: 0.25.0
+
+           Add `packing` option
+
     """
 
     if end is not None:
         _end = end
     else:
         _end = float(np.finfo(np.float64).max)
+    if packing is not None:
+        return _packed_data_matrix_from_tables(
+            tables,
+            samples,
+            record_neutral,
+            record_selected,
+            include_fixations,
+            begin,
+            _end,
+            packing,
+        )
     return DataMatrix(
         _data_matrix_from_tables(
             tables,
@@ -80,3 +109,74 @@ def data_matrix_from_tables(
             _end,
         )
     )
+
+
+def data_matrices_from_tables(
+    tables: TableCollection,
+    samples: Union[List, np.ndarray],
+    intervals: List[Tuple[float, float]],
+    *,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+    include_fixations: bool = False,
+    num_threads: int = 1,
+    packing: Optional[str] = None,
+) -> Union[List[DataMatrix], List[PackedDataMatrix]]:
+    """
+    Create a :class:`fwdpy11.DataMatrix` for each of several
+    genomic intervals.
+
+    :param tables: A TableCollection
+    :type tables: fwdpy11.TableCollection
+    :param samples: A list of sample nodes
+    :type samples: list or :class:`numpy.ndarray`
+    :param intervals: The :math:`[start, stop)` positions of each interval
+    :type intervals: list[tuple]
+    :param record_neutral: (True) If True, generate data for neutral variants
+    :type record_neutral: bool
+    :param record_selected: (True) If True, generate data for selected variants
+    :type record_selected: bool
+    :param include_fixations: (False) Whether to include variants fixed in the sample
+    :type include_fixations: bool
+    :param num_threads: (1) Number of threads used to process the intervals
+    :type num_threads: int
+    :param packing: (None) Either ``"haplotype"`` or ``"dosage"``
+    :type packing: str
+
+    :returns: One matrix per interval, in the order of `intervals`
+    :rtype: list[:class:`fwdpy11.DataMatrix`] or list[:class:`fwdpy11.PackedDataMatrix`]
+
+    The intervals have the same requirements as for
+    :class:`fwdpy11.DataMatrixIterator`.
+    They are split into `num_threads` blocks of consecutive intervals,
+    and each block is traversed by its own thread.
+    The GIL is released while the matrices are generated.
+
+    If `packing` is not None, each window is packed
+    as described for :func:`fwdpy11.data_matrix_from_tables`.
+
+    .. versionadded:: 0.25.0
+    """
+    if packing is not None:
+        return _windowed_packed_data_matrices(
+            tables,
+            samples,
+            intervals,
+            record_neutral,
+            record_selected,
+            include_fixations,
+            num_threads,
+            packing,
+        )
+    return [
+        DataMatrix(i)
+        for i in _windowed_data_matrices(
+            tables,
+            samples,
+            intervals,
+            record_neutral,
+            record_selected,
+            include_fixations,
+            num_threads,
+        )
+    ]
@@ -6,7 +6,10 @@ import numpy as np
 
 
 def simplify_tables(
-    tables: fwdpy11._types.TableCollection, samples: Union[List, np.ndarray]
+    tables: fwdpy11._types.TableCollection,
+    samples: Union[List, np.ndarray],
+    *,
+    num_threads: int = 1,
 ) -> Tuple[fwdpy11._types.TableCollection, np.ndarray]:
     """
     Simplify a TableCollection.
@@ -15,13 +18,30 @@ def simplify_tables(
     :type pop: :class:`fwdpy11.TableCollection`
     :param samples: list of samples
     :type list: list-like or array-like
+    :param num_threads: Number of genomic intervals to simplify in parallel.
+    :type num_threads: int
 
     :returns: A simplified TableCollection and an array containing remapped sample ids.
     :rtype: tuple
 
+    When `num_threads` is greater than one, the genome is split into
+    intervals containing similar numbers of edges.
+    Each interval is simplified in a separate thread and the results
+    are combined.
+    The number of intervals is at most the number of hardware threads.
+    The ids of non-sample nodes in the output are sorted by
+    decreasing birth time, so the output does not depend on the value
+    of `num_threads`.
+
     .. versionadded:: 0.3.0
 
+    .. versionchanged:: 0.25.0
+
+        Added `num_threads`.
+
     """
-    ll_t, idmap = fwdpy11._fwdpy11._simplify_tables(tables, samples)
+    ll_t, idmap = fwdpy11._fwdpy11._simplify_tables(
+        tables, samples, num_threads=num_threads
+    )
 
     return fwdpy11._types.TableCollection(ll_t), idmap
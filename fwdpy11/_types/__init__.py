@@ -22,7 +22,7 @@
 from .population_mixin import PopulationMixin  # NOQA
 from .table_collection import TableCollection  # NOQA
 from .tree_iterator import TreeIterator  # NOQA
-from .variant_iterator import VariantIterator  # NOQA
+from .variant_iterator import VariantChunk, VariantIterator  # NOQA
 from .data_matrix import DataMatrix  # NOQA
 from .data_matrix_iterator import DataMatrixIterator  # NOQA
 from .diploid_population import DiploidPopulation  # NOQA
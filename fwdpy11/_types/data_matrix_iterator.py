@@ -21,7 +21,7 @@ from typing import List, Tuple, Union
 
 import numpy as np
 
-from .._fwdpy11 import ll_DataMatrixIterator
+from .._fwdpy11 import PackedDataMatrix, ll_DataMatrixIterator
 from .._types import TableCollection
 
 
@@ -102,6 +102,19 @@ class DataMatrixIterator(ll_DataMatrixIterator):
         """Positions of selected variants."""
         return self._selected_positions
 
+    def packed(self, packing: str) -> PackedDataMatrix:
+        """
+        Bit-packed copy of the current window.
+
+        :param packing: Either ``"haplotype"`` or ``"dosage"``
+        :type packing: str
+
+        :rtype: :class:`fwdpy11.PackedDataMatrix`
+
+        .. versionadded:: 0.25.0
+        """
+        return self._packed(packing)
+
     def __next__(self):
         return self._ll_next()
 
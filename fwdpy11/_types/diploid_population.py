@@ -265,6 +265,63 @@ class DiploidPopulation(ll_DiploidPopulation, PopulationMixin):
         """Access the :class:`fwdpy11.TableCollection`"""
         return self._pytables
 
+    def genetic_values_from_nodes(
+        self,
+        gvalue,
+        nodes: np.ndarray,
+        keys: Optional[Iterable[int]] = None,
+        demes: Optional[Iterable[int]] = None,
+    ) -> np.ndarray:
+        """
+        Calculate genetic values of individuals from the tree sequence.
+
+        :param gvalue: A genetic value object
+        :type gvalue: :class:`fwdpy11.Additive`,
+                      :class:`fwdpy11.Multiplicative`, or
+                      :class:`fwdpy11.AdditivePleiotropy`
+        :param nodes: The two nodes of each individual, with shape ``(n, 2)``
+        :type nodes: numpy.ndarray
+        :param keys: Mutation keys to include.
+                     Defaults to all non-neutral mutations in the tables.
+        :type keys: list
+        :param demes: The deme of each individual.
+                      Defaults to deme 0 for every individual.
+        :type demes: list
+
+        :return: One genetic value per individual, or an array with
+                 one row per individual and one column per trait
+                 for :class:`fwdpy11.AdditivePleiotropy`.
+        :rtype: numpy.ndarray
+
+        The trees are traversed once, accumulating the effects of
+        mutations on each node and its descendants, so that the cost
+        depends on the size of the tree sequence rather than on the
+        number of individuals times the number of mutations.
+        Only mutations present in the tables contribute, in addition
+        to the fixations folded into ``gvalue.fixation_baseline``.
+        If the population has folded fixations, ``gvalue`` must be
+        the object that they were folded into.
+        Thus, the values agree with the metadata of alive or preserved
+        individuals when selected fixations are not removed from
+        the tables or are folded into the baseline.
+        Multiplicative values agree up to rounding error.
+
+        .. versionadded:: 0.25.0
+        """
+        nodes = np.asarray(nodes, dtype=np.int32)
+        if keys is None:
+            mutations = np.array(self.tables.mutations, copy=False)
+            keys = np.unique(mutations["key"][mutations["neutral"] == 0])
+        if demes is None:
+            demes = []
+        return fwdpy11._fwdpy11._genetic_values_from_nodes(
+            self,
+            gvalue,
+            nodes,
+            [int(k) for k in keys],
+            [int(d) for d in demes],
+        )
+
     def _get_times(self):
         amd = np.array(self.ancient_sample_metadata, copy=False)
         nodes = np.array(self.tables.nodes, copy=False)
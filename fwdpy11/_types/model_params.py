@@ -189,6 +189,10 @@ class ModelParams(object):
     Such warnings should not be ignored as they suggest that a simulation
     may not be giving biologically sensible results.
 
+    To remove selected fixations without changing genetic values,
+    set ``prune_selected`` to ``False`` and pass
+    ``fold_selected_fixations=True`` to :func:`fwdpy11.evolvets`.
+
     .. versionadded:: 0.1.1
 
     .. versionchanged:: 0.2.0
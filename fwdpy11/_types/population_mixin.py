@@ -45,6 +45,18 @@ class PopulationMixin(object):
     def fixation_times(self) -> Iterable[int]:
         return self._fixation_times  # type: ignore
 
+    @property
+    def num_folded_fixations(self) -> int:
+        """
+        The number of selected fixations removed from genomes
+        after being folded into the fixation baseline of the
+        genetic value objects.
+        See ``fold_selected_fixations`` in :func:`fwdpy11.evolvets`.
+
+        .. versionadded:: 0.25.0
+        """
+        return self._num_folded_fixations  # type: ignore
+
     @property
     def generation(self) -> int:
         return self._generation  # type: ignore
@@ -61,6 +61,14 @@ class TreeIterator(ll_TreeIterator):
 
         Add begin, end options as floats for initializing
 
+    .. versionchanged:: 0.25.0
+
+        Iteration starting at `begin` only visits the trees to the
+        left of `begin` if that is cheaper than copying the edges
+        from the tree containing `begin` onwards.
+        Added :meth:`TreeIterator.seek` and read-only array views
+        of the current tree.
+
     """
 
     def __init__(
@@ -177,9 +185,79 @@ class TreeIterator(ll_TreeIterator):
         """
         :return: The samples list
         :rtype: numpy.ndarray
+
+        .. versionchanged:: 0.25.0
+
+            The return value is a read-only view
+            of a list stored by the iterator.
         """
         return self._samples()
 
+    def seek(self, position: float) -> None:
+        """
+        Make the current tree the one containing a position.
+
+        :param position: A position in ``[begin, end)``
+        :type position: float
+
+        Nothing happens if `position` is in the current tree.
+        Otherwise, the iterator either visits the trees up to the
+        target or is rebuilt from a copy of the node table and of
+        the edges overlapping or to the right of the target tree,
+        whichever processes fewer edges.  Finding the target tree
+        takes logarithmic time, but a rebuild takes time linear in
+        the number of nodes and copied edges.  To move to the next
+        tree, continue iterating as usual.
+
+        .. versionadded:: 0.25.0
+        """
+        self._seek(position)
+
+    @property
+    def parent_array(self) -> np.ndarray:
+        """
+        Read-only view of the parent of each node in the current tree.
+
+        The view is updated in place during iteration,
+        so copy it to keep the values for a given tree.
+        Views obtained before a call to :meth:`TreeIterator.seek`
+        are no longer updated.
+
+        .. versionadded:: 0.25.0
+        """
+        return self._parent_array
+
+    @property
+    def left_child_array(self) -> np.ndarray:
+        """
+        Read-only view of the left child of each node in the current tree.
+        See :attr:`TreeIterator.parent_array` for details.
+
+        .. versionadded:: 0.25.0
+        """
+        return self._left_child_array
+
+    @property
+    def right_sib_array(self) -> np.ndarray:
+        """
+        Read-only view of the right sib of each node in the current tree.
+        See :attr:`TreeIterator.parent_array` for details.
+
+        .. versionadded:: 0.25.0
+        """
+        return self._right_sib_array
+
+    @property
+    def leaf_counts_array(self) -> np.ndarray:
+        """
+        Read-only view of the number of samples below each node
+        in the current tree.
+        See :attr:`TreeIterator.parent_array` for details.
+
+        .. versionadded:: 0.25.0
+        """
+        return self._leaf_counts_array
+
     def samples_below(self, node: int, sort=False) -> np.ndarray:
         """
         Return the list of samples descending from a node.
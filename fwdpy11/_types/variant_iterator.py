@@ -17,14 +17,33 @@
 # along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
 #
 
-from typing import List, Optional, Union
+from typing import Iterable, Iterator, List, NamedTuple, Optional, Union
 
 import numpy as np
 
-from .._fwdpy11 import MutationRecord, Site, ll_VariantIterator
+from .._fwdpy11 import MutationRecord, MutationVector, Site, ll_VariantIterator
 from .table_collection import TableCollection
 
 
+class VariantChunk(NamedTuple):
+    """
+    A block of variants from :func:`fwdpy11.VariantIterator.chunks`.
+
+    Row ``i`` of each array refers to the same mutation.
+
+    .. versionadded:: 0.25.0
+    """
+
+    genotypes: np.ndarray
+    """Genotypes, with one row per mutation and one column per sample"""
+    positions: np.ndarray
+    """Mutation positions"""
+    keys: np.ndarray
+    """Mutation keys"""
+    effect_sizes: np.ndarray
+    """Effect sizes, or ``nan`` if no mutations were given"""
+
+
 class VariantIterator(ll_VariantIterator):
     """
     An iterable class for traversing genotypes in a tree sequence.
@@ -105,6 +124,71 @@ class VariantIterator(ll_VariantIterator):
         """:class:`fwdpy11.MutationRecord` objects for the current Site."""
         return self._records
 
+    def chunks(
+        self,
+        chunk_size: int,
+        *,
+        mutations: Optional[MutationVector] = None,
+        labels: Optional[Iterable[int]] = None,
+        min_maf: float = 0.0,
+    ) -> Iterator[VariantChunk]:
+        """
+        Iterate over blocks of up to `chunk_size` variants.
+
+        :param chunk_size: Maximum number of rows per block
+        :type chunk_size: int
+        :param mutations: (None) The mutations of the population,
+                          used to fill in effect sizes and to filter
+                          on labels
+        :type mutations: :class:`fwdpy11.MutationVector`
+        :param labels: (None) If not None, only include mutations
+                       whose label is in this collection
+        :type labels: list[int]
+        :param min_maf: (0.0) Only include mutations whose minor
+                        allele frequency in the sample is at least
+                        this value
+        :type min_maf: float
+
+        :rtype: iterator over :class:`fwdpy11.VariantChunk`
+
+        There is one row per mutation, so a site with more than one
+        mutation takes more than one row.
+        Mutations are also filtered by the neutral and selected
+        options given at initialization, and mutations not present
+        in the sample are skipped.
+        All filtering happens in C++ while the rows are filled,
+        with the GIL released.
+
+        The arrays of each block are views of buffers that are
+        allocated once and refilled by the next block.
+        Copy them to keep the data.
+
+        This method and iteration over single variants
+        both advance the same underlying state.  Use only one
+        of them for a given instance.
+
+        .. versionadded:: 0.25.0
+        """
+        if chunk_size < 1:
+            raise ValueError("chunk_size must be > 0")
+        if min_maf < 0.0 or min_maf > 0.5:
+            raise ValueError("min_maf must be in [0, 0.5]")
+        nsamples = len(self._genotypes)
+        genotypes = np.zeros((chunk_size, nsamples), dtype=np.int8)
+        positions = np.zeros(chunk_size, dtype=np.float64)
+        keys = np.zeros(chunk_size, dtype=np.uint64)
+        effect_sizes = np.zeros(chunk_size, dtype=np.float64)
+        _labels = [] if labels is None else [int(i) for i in labels]
+        while True:
+            n = self._fill_chunk(
+                genotypes, positions, keys, effect_sizes, mutations, _labels, min_maf
+            )
+            if n == 0:
+                return
+            yield VariantChunk(genotypes[:n], positions[:n], keys[:n], effect_sizes[:n])
+            if n < chunk_size:
+                return
+
     @property
     def site(self) -> Site:
         """The current :class:`fwdpy11.Site`"""
@@ -117,6 +117,32 @@ def attr_class_pickle_with_super(cls):
     return _add_getstate(cls)
 
 
+def attr_class_pickle_with_fixation_baseline(cls):
+    """
+    As attr_class_pickle_with_super, for genetic value
+    types whose C++ base also stores a baseline of folded
+    selected fixations, which is not an attribute.
+    """
+
+    def getstate(self):
+        return (self.asdict(), self.fixation_baseline, self._num_folded_fixations)
+
+    def setstate(self, state):
+        if isinstance(state, dict):
+            # Pickled without a baseline
+            d, baseline = state, None
+        else:
+            d, baseline, num_folded_fixations = state
+        self.__dict__.update(d)
+        self.__attrs_post_init__()
+        if baseline is not None:
+            self._set_fixation_baseline(baseline, num_folded_fixations)
+
+    cls.__getstate__ = getstate
+    cls.__setstate__ = setstate
+    return cls
+
+
 def region_custom_repr(cls):
     """
     Custom repr to correctly display weight for region instances
@@ -17,6 +17,7 @@
 # along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
 #
 
+import ctypes
 import typing
 
 import attr
@@ -27,6 +28,8 @@ from ._fwdpy11 import (
     GeneticValueIsTrait,
     GeneticValueNoise,
     _ll_Additive,
+    _ll_CFunctionGeneticValue,
+    _ll_CFunctionGeneticValueToFitnessMap,
     _ll_GaussianNoise,
     _ll_GBR,
     _ll_GaussianStabilizingSelection,
@@ -40,6 +43,7 @@ from ._fwdpy11 import (
     _PyDiploidGeneticValue,
 )
 from .class_decorators import (
+    attr_class_pickle_with_fixation_baseline,
     attr_class_pickle_with_super,
     attr_class_to_from_dict,
     attr_class_to_from_dict_no_recurse,
@@ -52,6 +56,25 @@ class TimingError(Exception):
     pass
 
 
+def _function_address(function) -> int:
+    """
+    Get the address of a compiled function.
+
+    Accepts an integer address, an object with an ``address``
+    attribute (such as a ``numba.cfunc``), or a :mod:`ctypes`
+    function pointer.
+    """
+    if isinstance(function, int):
+        address = function
+    elif hasattr(function, "address"):
+        address = function.address
+    else:
+        address = ctypes.cast(function, ctypes.c_void_p).value
+    if address is None or address == 0:
+        raise ValueError("function address cannot be NULL")
+    return address
+
+
 @attr_class_pickle_with_super
 @attr_class_to_from_dict
 @attr.s(auto_attribs=True, frozen=True, auto_detect=True)
@@ -273,7 +296,7 @@ class GaussianNoise(_ll_GaussianNoise):
         super(GaussianNoise, self).__init__(self.sd, self.mean)
 
 
-@attr_class_pickle_with_super
+@attr_class_pickle_with_fixation_baseline
 @attr_class_to_from_dict_no_recurse
 @attr.s(auto_attribs=True, frozen=True)
 class Additive(_ll_Additive):
@@ -306,6 +329,12 @@ class Additive(_ll_Additive):
 
         Refactored to use attrs and inherit from
         low-level C++ class
+
+    .. versionchanged:: 0.25.0
+
+        Support folding selected fixations into
+        :attr:`fwdpy11.DiploidGeneticValue.fixation_baseline`.
+        See ``fold_selected_fixations`` in :func:`fwdpy11.evolvets`.
     """
 
     scaling: float
@@ -324,7 +353,7 @@ class Additive(_ll_Additive):
         self.gvalue_to_fitness.validate_timings(deme, demography)
 
 
-@attr_class_pickle_with_super
+@attr_class_pickle_with_fixation_baseline
 @attr_class_to_from_dict_no_recurse
 @attr.s(auto_attribs=True, frozen=True)
 class Multiplicative(_ll_Multiplicative):
@@ -357,6 +386,12 @@ class Multiplicative(_ll_Multiplicative):
 
         Refactored to use attrs and inherit from
         low-level C++ class
+
+    .. versionchanged:: 0.25.0
+
+        Support folding selected fixations into
+        :attr:`fwdpy11.DiploidGeneticValue.fixation_baseline`.
+        See ``fold_selected_fixations`` in :func:`fwdpy11.evolvets`.
     """
 
     scaling: float
@@ -415,7 +450,7 @@ class GBR(_ll_GBR):
         self.gvalue_to_fitness.validate_timings(deme, demography)
 
 
-@attr_class_pickle_with_super
+@attr_class_pickle_with_fixation_baseline
 @attr_class_to_from_dict_no_recurse
 @attr.s(auto_attribs=True, frozen=True)
 class AdditivePleiotropy(_ll_StrictAdditiveMultivariateEffects):
@@ -447,6 +482,12 @@ class AdditivePleiotropy(_ll_StrictAdditiveMultivariateEffects):
 
         Refactored to use attrs and inherit from
         low-level C++ class
+
+    .. versionchanged:: 0.25.0
+
+        Support folding selected fixations into
+        :attr:`fwdpy11.DiploidGeneticValue.fixation_baseline`.
+        See ``fold_selected_fixations`` in :func:`fwdpy11.evolvets`.
     """
 
     ndimensions: int
@@ -479,3 +520,115 @@ class PyDiploidGeneticValue(_PyDiploidGeneticValue):
         if self.gvalue_to_fitness is None:
             return
         self.gvalue_to_fitness.validate_timings(deme, demography)
+
+
+@attr_class_to_from_dict_no_recurse
+@attr.s(auto_attribs=True, frozen=True)
+class CFunctionGeneticValueToFitnessMap(_ll_CFunctionGeneticValueToFitnessMap):
+    """
+    Map genetic values to fitness using a compiled function.
+
+    This class has the following attributes, whose names
+    are also `kwargs` for intitialization.  The attribute names
+    also determine the order of positional arguments:
+
+    :param function: The function.  A reference to it is kept
+                     for the lifetime of this object.
+    :type function: int or numba.cfunc or ctypes function pointer
+    :param ndim: Number of trait dimensions
+    :type ndim: int
+    :param user_data: Address passed on as the last argument of `function`
+    :type user_data: int
+
+    The C signature of `function` must be:
+
+    .. code-block:: c
+
+        double function(const double *gvalues, size_t ndim,
+                        double g, double e, void *user_data);
+
+    The return value is fitness.
+    The function should be compiled code, such as a
+    ``numba.cfunc``, that does not need the GIL.
+
+    Instances of this class cannot be pickled.
+
+    .. versionadded:: 0.25.0
+    """
+
+    function: object
+    ndim: int = 1
+    user_data: int = 0
+
+    def __attrs_post_init__(self):
+        super(CFunctionGeneticValueToFitnessMap, self).__init__(
+            _function_address(self.function), self.user_data, self.ndim
+        )
+
+    def validate_timings(self, deme: int, demography: ForwardDemesGraph) -> None:
+        pass
+
+
+@attr_class_to_from_dict_no_recurse
+@attr.s(auto_attribs=True, frozen=True)
+class CFunctionGeneticValue(_ll_CFunctionGeneticValue):
+    """
+    Genetic values calculated by a compiled function.
+
+    This class has the following attributes, whose names
+    are also `kwargs` for intitialization.  The attribute names
+    also determine the order of positional arguments:
+
+    :param function: The function.  A reference to it is kept
+                     for the lifetime of this object.
+    :type function: int or numba.cfunc or ctypes function pointer
+    :param ndim: Number of trait dimensions
+    :type ndim: int
+    :param gvalue_to_fitness: How to map trait value to fitness
+    :type gvalue_to_fitness: fwdpy11.GeneticValueIsTrait
+    :param noise: Random effects on trait values
+    :type noise: fwdpy11.GeneticValueNoise
+    :param user_data: Address passed on as the last argument of `function`
+    :type user_data: int
+
+    The C signature of `function` must be:
+
+    .. code-block:: c
+
+        void function(const uint32_t *genome1, size_t genome1_size,
+                      const uint32_t *genome2, size_t genome2_size,
+                      const double *effect_sizes, const double *dominance,
+                      double *gvalues, size_t ndim, void *user_data);
+
+    `genome1` and `genome2` are the keys of the selected mutations
+    in the individual's two genomes.
+    `effect_sizes` and `dominance` are indexed by these keys.
+    The function must fill `gvalues[0]` through `gvalues[ndim - 1]`.
+    :attr:`fwdpy11.DiploidMetadata.g` is set to `gvalues[0]`.
+    The function should be compiled code, such as a
+    ``numba.cfunc``, that does not need the GIL.
+
+    Instances of this class cannot be pickled.
+
+    .. versionadded:: 0.25.0
+    """
+
+    function: object
+    ndim: int = 1
+    gvalue_to_fitness: object = None
+    noise: object = None
+    user_data: int = 0
+
+    def __attrs_post_init__(self):
+        super(CFunctionGeneticValue, self).__init__(
+            _function_address(self.function),
+            self.user_data,
+            self.ndim,
+            self.gvalue_to_fitness,
+            self.noise,
+        )
+
+    def validate_timings(self, deme: int, demography: ForwardDemesGraph) -> None:
+        if self.gvalue_to_fitness is None:
+            return
+        self.gvalue_to_fitness.validate_timings(deme, demography)
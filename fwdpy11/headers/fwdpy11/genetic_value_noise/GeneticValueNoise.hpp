@@ -40,6 +40,15 @@ namespace fwdpy11
         operator()(const DiploidGeneticValueNoiseData /*data*/) const = 0;
         virtual void update(const DiploidPopulation& /*pop*/) = 0;
         virtual std::shared_ptr<GeneticValueNoise> clone() const = 0;
+
+        virtual bool
+        noise_batch(const GSLrng_t& /*rng*/, std::size_t /*n*/, double* /*e*/) const
+        /// Optional batch interface for noise that does not
+        /// depend on the individual.  Fills e[0:n] and returns
+        /// true, or returns false if not supported.
+        {
+            return false;
+        }
     };
 } // namespace fwdpy11
 
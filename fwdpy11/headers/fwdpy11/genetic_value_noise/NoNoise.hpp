@@ -20,6 +20,7 @@
 #ifndef FWDPY11_NO_NOISE_HPP
 #define FWDPY11_NO_NOISE_HPP
 
+#include <algorithm>
 #include "GeneticValueNoise.hpp"
 
 namespace fwdpy11
@@ -32,6 +33,13 @@ namespace fwdpy11
             return 0.;
         }
 
+        bool
+        noise_batch(const GSLrng_t& /*rng*/, std::size_t n, double* e) const override
+        {
+            std::fill(e, e + n, 0.);
+            return true;
+        }
+
         void
         update(const DiploidPopulation& /*pop*/) override
         {
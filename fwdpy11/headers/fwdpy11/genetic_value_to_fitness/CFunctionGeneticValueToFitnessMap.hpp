@@ -0,0 +1,78 @@
+//
+// Copyright (C) 2026 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_CFUNCTION_GENETIC_VALUE_TO_FITNESS_MAP_HPP__
+#define FWDPY11_CFUNCTION_GENETIC_VALUE_TO_FITNESS_MAP_HPP__
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include "GeneticValueIsTrait.hpp"
+
+extern "C" {
+/// Signature of a compiled genetic value to fitness function.
+///
+/// gvalues[0:ndim] are the offspring's genetic values,
+/// g is DiploidMetadata::g and e is DiploidMetadata::e.
+/// Returns fitness.  It is expected to be compiled code
+/// that does not need the GIL.
+typedef double (*fwdpy11_gvalue_to_fitness_function)(const double* gvalues,
+                                                     std::size_t ndim, double g,
+                                                     double e, void* user_data);
+}
+
+namespace fwdpy11
+{
+    struct CFunctionGeneticValueToFitnessMap : public GeneticValueIsTrait
+    {
+        fwdpy11_gvalue_to_fitness_function function;
+        void* user_data;
+
+        CFunctionGeneticValueToFitnessMap(fwdpy11_gvalue_to_fitness_function f,
+                                          void* data, std::size_t ndim)
+            : GeneticValueIsTrait(ndim), function{f}, user_data{data}
+        {
+            if (function == nullptr)
+                {
+                    throw std::invalid_argument("function pointer cannot be NULL");
+                }
+        }
+
+        double
+        operator()(const DiploidGeneticValueToFitnessData data) const override
+        {
+            const auto& md = data.offspring_metadata.get();
+            return function(data.gvalues.get().data(), total_dim, md.g, md.e,
+                            user_data);
+        }
+
+        void
+        update(const DiploidPopulation& /*pop*/) override
+        {
+        }
+
+        std::shared_ptr<GeneticValueToFitnessMap>
+        clone() const override
+        {
+            return std::make_shared<CFunctionGeneticValueToFitnessMap>(
+                function, user_data, total_dim);
+        }
+    };
+} // namespace fwdpy11
+
+#endif
@@ -2,6 +2,7 @@
 #define FWDPY11_GSSMO
 
 #include <algorithm>
+#include <cmath>
 #include <vector>
 #include "GeneticValueIsTrait.hpp"
 #include "Optimum.hpp"
@@ -49,6 +50,24 @@ namespace fwdpy11
                               / (2.0 * VS)));
         }
 
+        bool
+        map_batch(const double * /*gvalues*/, const double *g, const double *e,
+                  std::size_t n, double *w) const override
+        {
+            // Keeping exp out of the first loop
+            // lets that loop vectorise.
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    double d = g[i] + e[i] - opt;
+                    w[i] = -(d * d) / (2.0 * VS);
+                }
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    w[i] = std::exp(w[i]);
+                }
+            return true;
+        }
+
         template <typename poptype>
         inline void
         update_details(const poptype &pop)
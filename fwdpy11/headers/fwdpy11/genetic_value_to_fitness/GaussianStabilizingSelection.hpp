@@ -29,6 +29,13 @@ namespace fwdpy11
             return this->pimpl->operator()(data);
         }
 
+        bool
+        map_batch(const double *gvalues, const double *g, const double *e,
+                  std::size_t n, double *w) const final
+        {
+            return this->pimpl->map_batch(gvalues, g, e, n, w);
+        }
+
         void
         update(const DiploidPopulation &pop) final
         {
@@ -20,6 +20,7 @@
 #ifndef FWDPY11_GENETIC_VALUE_IS_FITNESS
 #define FWDPY11_GENETIC_VALUE_IS_FITNESS
 
+#include <algorithm>
 #include "GeneticValueToFitnessMap.hpp"
 
 namespace fwdpy11
@@ -37,6 +38,14 @@ namespace fwdpy11
             return data.offspring_metadata.get().g;
         }
 
+        bool
+        map_batch(const double * /*gvalues*/, const double *g, const double * /*e*/,
+                  std::size_t n, double *w) const override
+        {
+            std::copy(g, g + n, w);
+            return true;
+        }
+
         void
         update(const DiploidPopulation & /*pop*/) override
         {
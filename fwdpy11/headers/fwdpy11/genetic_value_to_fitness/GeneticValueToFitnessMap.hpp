@@ -53,6 +53,18 @@ namespace fwdpy11
         operator()(const DiploidGeneticValueToFitnessData /*data*/) const = 0;
         virtual void update(const DiploidPopulation& /*pop*/) = 0;
         virtual std::shared_ptr<GeneticValueToFitnessMap> clone() const = 0;
+
+        virtual bool
+        map_batch(const double* /*gvalues*/, const double* /*g*/, const double* /*e*/,
+                  std::size_t /*n*/, double* /*w*/) const
+        /// Optional batch interface.  gvalues holds n rows of
+        /// total_dim genetic values.  g and e hold the
+        /// DiploidMetadata fields of the same n individuals.
+        /// Fills w[0:n] and returns true, or returns false
+        /// if not supported.
+        {
+            return false;
+        }
     };
 } //namespace fwdpy11
 
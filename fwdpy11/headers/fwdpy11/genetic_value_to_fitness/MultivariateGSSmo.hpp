@@ -27,6 +27,7 @@
 #include <algorithm>
 #include "GeneticValueIsTrait.hpp"
 #include "PleiotropicOptima.hpp"
+#include <fwdpy11/genetic_values/multivariate_kernels.hpp>
 
 namespace fwdpy11
 {
@@ -75,15 +76,20 @@ namespace fwdpy11
                 {
                     throw std::runtime_error("dimension mismatch");
                 }
-            double sqdiff = 0.0;
-            for (std::size_t i = 0; i < data.gvalues.get().size(); ++i)
-                {
-                    sqdiff += gsl_pow_2(data.gvalues.get()[i]
-                                        - current_timepoint_optima[i]);
-                }
+            double sqdiff = fwdpy11::squared_distance(
+                data.gvalues.get().data(), current_timepoint_optima.data(), total_dim);
             return std::exp(-sqdiff / (2.0 * VW));
         }
 
+        bool
+        map_batch(const double *gvalues, const double * /*g*/, const double * /*e*/,
+                  std::size_t n, double *w) const override
+        {
+            fwdpy11::multivariate_gaussian_fitness(
+                gvalues, n, total_dim, current_timepoint_optima.data(), VW, w);
+            return true;
+        }
+
         std::shared_ptr<GeneticValueToFitnessMap>
         clone() const override
         {
@@ -0,0 +1,125 @@
+//
+// Copyright (C) 2026 Kevin Thornton <krthornt@uci.edu>
+//
+// This file is part of fwdpy11.
+//
+// fwdpy11 is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+//
+// fwdpy11 is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+//
+#ifndef FWDPY11_CFUNCTION_GENETIC_VALUE_HPP__
+#define FWDPY11_CFUNCTION_GENETIC_VALUE_HPP__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+#include "DiploidGeneticValue.hpp"
+#include "default_update.hpp"
+
+extern "C" {
+/// Signature of a compiled genetic value function.
+///
+/// genome1 and genome2 are the keys of the selected mutations
+/// on the two genomes of an individual. effect_sizes and dominance
+/// are indexed by key.  The function must fill gvalues[0:ndim].
+/// DiploidMetadata::g is set to gvalues[0].
+/// It is expected to be compiled code that does not need the GIL.
+typedef void (*fwdpy11_gvalue_function)(
+    const std::uint32_t* genome1, std::size_t genome1_size,
+    const std::uint32_t* genome2, std::size_t genome2_size,
+    const double* effect_sizes, const double* dominance, double* gvalues,
+    std::size_t ndim, void* user_data);
+}
+
+namespace fwdpy11
+{
+    class CFunctionGeneticValue : public DiploidGeneticValue
+    /// Genetic values calculated by a C function pointer,
+    /// such as a numba cfunc or a function from a shared library.
+    {
+      private:
+        std::vector<double> effect_sizes, dominance;
+
+        void
+        fill_mutation_columns(const DiploidPopulation& pop)
+        {
+            effect_sizes.resize(pop.mutations.size());
+            dominance.resize(pop.mutations.size());
+            for (std::size_t i = 0; i < pop.mutations.size(); ++i)
+                {
+                    effect_sizes[i] = pop.mutations[i].s;
+                    dominance[i] = pop.mutations[i].h;
+                }
+        }
+
+        void
+        call(const DiploidPopulation& pop, const DiploidMetadata& md, double* output)
+        {
+            const auto& dip = pop.diploids[md.label];
+            const auto& g1 = pop.haploid_genomes[dip.first].smutations;
+            const auto& g2 = pop.haploid_genomes[dip.second].smutations;
+            function(g1.data(), g1.size(), g2.data(), g2.size(), effect_sizes.data(),
+                     dominance.data(), output, total_dim, user_data);
+        }
+
+      public:
+        fwdpy11_gvalue_function function;
+        void* user_data;
+
+        CFunctionGeneticValue(fwdpy11_gvalue_function f, void* data,
+                              std::size_t ndim,
+                              const GeneticValueToFitnessMap* gv2w_,
+                              const GeneticValueNoise* noise_)
+            : DiploidGeneticValue(ndim, gv2w_, noise_), effect_sizes{}, dominance{},
+              function{f}, user_data{data}
+        {
+            if (function == nullptr)
+                {
+                    throw std::invalid_argument("function pointer cannot be NULL");
+                }
+        }
+
+        double
+        calculate_gvalue(const DiploidGeneticValueData data) override
+        // Only used outside of simulations, as calculate_gvalues
+        // handles all individuals during a simulation.
+        {
+            fill_mutation_columns(data.pop.get());
+            call(data.pop.get(), data.offspring_metadata.get(), gvalues.data());
+            return gvalues[0];
+        }
+
+        bool
+        calculate_gvalues(const GSLrng_t& /*rng*/, const DiploidPopulation& pop,
+                          const std::vector<DiploidMetadata>& offspring_metadata,
+                          const std::vector<std::size_t>& individuals,
+                          std::vector<double>& batch_gvalues) override
+        {
+            // New mutations are added while generating offspring,
+            // so the columns are refreshed every generation.
+            fill_mutation_columns(pop);
+            batch_gvalues.resize(individuals.size() * total_dim);
+            for (std::size_t i = 0; i < individuals.size(); ++i)
+                {
+                    call(pop, offspring_metadata[individuals[i]],
+                         batch_gvalues.data() + i * total_dim);
+                }
+            return true;
+        }
+
+        DEFAULT_DIPLOID_POP_UPDATE();
+    };
+} // namespace fwdpy11
+
+#endif
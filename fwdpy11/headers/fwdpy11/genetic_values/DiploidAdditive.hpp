@@ -8,8 +8,9 @@ namespace fwdpy11
 {
     struct single_deme_additive_het
     {
+        template <typename MutationType>
         inline void
-        operator()(double& d, const fwdpy11::Mutation& m) const
+        operator()(double& d, const MutationType& m) const
         {
             d += m.s * m.h;
         }
@@ -31,8 +32,9 @@ namespace fwdpy11
         {
         }
 
+        template <typename MutationType>
         inline void
-        operator()(double& d, const fwdpy11::Mutation& m) const
+        operator()(double& d, const MutationType& m) const
         {
             d += scaling * m.s;
         }
@@ -72,15 +74,15 @@ namespace fwdpy11
 
     using DiploidAdditive = fwdpy11::stateless_site_dependent_genetic_value_wrapper<
         single_deme_additive_het, single_deme_additive_hom, multi_deme_additive_het,
-        multi_deme_additive_hom, 0>;
+        multi_deme_additive_hom, 0, final_additive_trait, final_additive_fitness,
+        never_clamp>;
 
     inline DiploidAdditive
     additive_fitness_model(std::size_t ndemes, double scaling,
                            const GeneticValueNoise* noise)
     {
-        return DiploidAdditive(
-            ndemes, scaling, final_additive_fitness(),
-            [](const double) { return false; }, nullptr, noise);
+        return DiploidAdditive(builtin_genetic_value_model(), ndemes, scaling, nullptr,
+                               noise);
     }
 
     inline DiploidAdditive
@@ -88,9 +90,8 @@ namespace fwdpy11
                          const GeneticValueIsTrait* gvalue_to_fitness,
                          const GeneticValueNoise* noise)
     {
-        return DiploidAdditive(
-            ndemes, scaling, final_additive_trait(), [](const double) { return false; },
-            gvalue_to_fitness, noise);
+        return DiploidAdditive(builtin_genetic_value_model(), ndemes, scaling,
+                               gvalue_to_fitness, noise);
     }
 
 }
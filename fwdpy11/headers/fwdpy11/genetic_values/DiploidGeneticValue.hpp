@@ -20,6 +20,7 @@
 #define FWDPY11_DIPLOID_GENETIC_VALUE_HPP__
 
 #include <cstdint>
+#include <stdexcept>
 #include <vector>
 #include <fwdpy11/rng.hpp>
 #include <fwdpy11/types/DiploidPopulation.hpp>
@@ -51,6 +52,14 @@ namespace fwdpy11
       public:
         std::size_t total_dim;
         std::vector<double> gvalues;
+        // Contributions of selected fixations that have been
+        // removed from genomes.  Empty unless the derived
+        // class supports fold_fixation.
+        std::vector<double> fixation_baseline;
+        // The number of fixations folded into fixation_baseline.
+        // Compared to Population::num_folded_fixations to make
+        // sure that the baseline belongs to the population.
+        std::uint64_t num_folded_fixations;
         // Even though these are stored as shared_ptr,
         // this class is non-copyable because its state
         // may change over time via the various update
@@ -60,7 +69,8 @@ namespace fwdpy11
 
         DiploidGeneticValue(std::size_t ndim, const GeneticValueToFitnessMap* gv2w_,
                             const GeneticValueNoise* noise)
-            : total_dim(ndim), gvalues(total_dim, 0.),
+            : total_dim(ndim), gvalues(total_dim, 0.), fixation_baseline{},
+              num_folded_fixations{0},
               gv2w{process_input<GeneticValueToFitnessMap, GeneticValueIsFitness,
                                  std::size_t>(gv2w_, ndim)},
               noise_fxn{process_input<GeneticValueNoise, NoNoise>(noise)}
@@ -78,11 +88,73 @@ namespace fwdpy11
 
         virtual void update(const DiploidPopulation& pop) = 0;
 
+        virtual bool
+        calculate_gvalues(const GSLrng_t& /*rng*/, const DiploidPopulation& /*pop*/,
+                          const std::vector<DiploidMetadata>& /*offspring_metadata*/,
+                          const std::vector<std::size_t>& /*individuals*/,
+                          std::vector<double>& /*batch_gvalues*/)
+        /// Optional batch interface.
+        ///
+        /// Derived classes may fill batch_gvalues with
+        /// individuals.size() rows of total_dim genetic values,
+        /// one row per element of individuals, which are indexes
+        /// into offspring_metadata.  Returning true means that
+        /// calculate_gvalue will not be called for these individuals.
+        /// The default returns false, meaning no batch calculation.
+        {
+            return false;
+        }
+
+        virtual std::size_t
+        focal_trait() const
+        /// The column of the rows filled by calculate_gvalues
+        /// that is stored in DiploidMetadata::g.
+        {
+            return 0;
+        }
+
+        virtual bool
+        can_fold_fixations() const
+        /// Returns true if fold_fixation is implemented.
+        {
+            return false;
+        }
+
+        virtual void
+        reset_fixation_baseline()
+        /// Restore fixation_baseline to its value
+        /// before any call to fold_fixation.
+        {
+        }
+
+        virtual void
+        fold_fixation(const Mutation& /*mutation*/)
+        /// Optional interface for pruning selected fixations.
+        ///
+        /// Called once for each selected mutation that is fixed
+        /// in every individual and that is about to be removed
+        /// from all genomes.  Derived classes add the homozygous
+        /// effect of the mutation to fixation_baseline so that
+        /// future genetic values are unchanged by its removal.
+        {
+            throw std::runtime_error(
+                "this genetic value type cannot fold selected fixations");
+        }
+
         // To be called from w/in a simulation
         inline void
         operator()(DiploidGeneticValueData data)
         {
             data.offspring_metadata.get().g = calculate_gvalue(data);
+            apply_noise_and_fitness(data);
+        }
+
+        inline void
+        apply_noise_and_fitness(DiploidGeneticValueData data)
+        /// Set the noise and fitness of an offspring whose
+        /// genetic value(s) are already in offspring_metadata.g
+        /// and gvalues.
+        {
             data.offspring_metadata.get().e = noise(DiploidGeneticValueNoiseData(data));
             data.offspring_metadata.get().w = genetic_value_to_fitness(
                 DiploidGeneticValueToFitnessData(data, gvalues));
@@ -99,6 +171,28 @@ namespace fwdpy11
         {
             return noise_fxn->operator()(data);
         }
+
+        // Batch versions of noise and genetic_value_to_fitness.
+        // Each returns false if the calculation must be done
+        // one individual at a time instead.
+
+        virtual bool
+        noise_batch(const GSLrng_t& rng, std::size_t n, double* e) const
+        {
+            return noise_fxn->noise_batch(rng, n, e);
+        }
+
+        virtual bool
+        genetic_value_to_fitness_batch(const double* batch_gvalues, const double* g,
+                                       const double* e, std::size_t n,
+                                       double* w) const
+        {
+            if (gv2w->total_dim != total_dim)
+                {
+                    return false;
+                }
+            return gv2w->map_batch(batch_gvalues, g, e, n, w);
+        }
     };
 } //namespace fwdpy11
 
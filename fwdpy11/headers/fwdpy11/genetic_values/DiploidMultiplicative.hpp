@@ -8,8 +8,9 @@ namespace fwdpy11
 {
     struct single_deme_multiplicative_het
     {
+        template <typename MutationType>
         inline void
-        operator()(double& d, const fwdpy11::Mutation& m) const
+        operator()(double& d, const MutationType& m) const
         {
             d *= (1. + m.s * m.h);
         }
@@ -31,8 +32,9 @@ namespace fwdpy11
         {
         }
 
+        template <typename MutationType>
         inline void
-        operator()(double& d, const fwdpy11::Mutation& m) const
+        operator()(double& d, const MutationType& m) const
         {
             d *= (1. + scaling * m.s);
         }
@@ -70,18 +72,28 @@ namespace fwdpy11
         }
     };
 
+    struct multiplicative_fitness_clamp
+    {
+        inline bool
+        operator()(const double w) const
+        {
+            return w <= 0.0;
+        }
+    };
+
     using DiploidMultiplicative
         = fwdpy11::stateless_site_dependent_genetic_value_wrapper<
             single_deme_multiplicative_het, single_deme_multiplicative_hom,
-            multi_deme_multiplicative_het, multi_deme_multiplicative_hom, 1>;
+            multi_deme_multiplicative_het, multi_deme_multiplicative_hom, 1,
+            final_multiplicative_trait, final_multiplicative_fitness,
+            multiplicative_fitness_clamp>;
 
     inline DiploidMultiplicative
     multiplicative_fitness_model(std::size_t ndemes, double scaling,
                                  const GeneticValueNoise* noise)
     {
-        return DiploidMultiplicative(
-            ndemes, scaling, final_multiplicative_fitness(),
-            [](const double w) { return w <= 0.0; }, nullptr, noise);
+        return DiploidMultiplicative(builtin_genetic_value_model(), ndemes, scaling,
+                                     nullptr, noise);
     }
 
     inline DiploidMultiplicative
@@ -89,8 +101,7 @@ namespace fwdpy11
                                const GeneticValueIsTrait* gvalue_to_fitness,
                                const GeneticValueNoise* noise)
     {
-        return DiploidMultiplicative(
-            ndemes, scaling, final_multiplicative_trait(),
-            [](const double) { return false; }, gvalue_to_fitness, noise);
+        return DiploidMultiplicative(builtin_genetic_value_model(), ndemes, scaling,
+                                     gvalue_to_fitness, noise);
     }
 }
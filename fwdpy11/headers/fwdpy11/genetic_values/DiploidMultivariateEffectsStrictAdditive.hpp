@@ -7,6 +7,7 @@
 #include <functional>
 #include "DiploidGeneticValue.hpp"
 #include "default_update.hpp"
+#include "multivariate_kernels.hpp"
 #include <fwdpy11/genetic_value_to_fitness/GeneticValueIsTrait.hpp>
 
 namespace fwdpy11
@@ -19,19 +20,21 @@ namespace fwdpy11
                                                  std::size_t focal_trait,
                                                  const GeneticValueIsTrait *gv2w_,
                                                  const GeneticValueNoise *noise_)
-            : DiploidGeneticValue(ndim, gv2w_, noise_), focal_trait_index(focal_trait)
+            : DiploidGeneticValue(ndim, gv2w_, noise_), focal_trait_index(focal_trait),
+              effect_matrix{}, valid_rows{}
         {
             if (focal_trait_index >= ndim)
                 {
                     throw std::invalid_argument(
                         "focal trait index must by < number of traits");
                 }
+            fixation_baseline.assign(total_dim, 0.0);
         }
 
         double
         calculate_gvalue(const fwdpy11::DiploidGeneticValueData data) override
         {
-            std::fill(begin(gvalues), end(gvalues), 0.0);
+            std::copy(begin(fixation_baseline), end(fixation_baseline), begin(gvalues));
 
             const auto &pop = data.pop.get();
             const auto diploid_index = data.offspring_metadata.get().label;
@@ -61,10 +64,91 @@ namespace fwdpy11
             return gvalues[focal_trait_index];
         }
 
+        bool
+        calculate_gvalues(const GSLrng_t & /*rng*/, const DiploidPopulation &pop,
+                          const std::vector<DiploidMetadata> &offspring_metadata,
+                          const std::vector<std::size_t> &individuals,
+                          std::vector<double> &batch_gvalues) override
+        {
+            // Copy the effect sizes into a contiguous matrix
+            // so that rows can be summed without indirection.
+            effect_matrix.assign(pop.mutations.size() * total_dim, 0.0);
+            valid_rows.assign(pop.mutations.size(), 0);
+            for (std::size_t i = 0; i < pop.mutations.size(); ++i)
+                {
+                    const auto &esizes = pop.mutations[i].esizes;
+                    if (esizes.size() == total_dim)
+                        {
+                            std::copy(begin(esizes), end(esizes),
+                                      begin(effect_matrix) + i * total_dim);
+                            valid_rows[i] = 1;
+                        }
+                }
+            batch_gvalues.resize(individuals.size() * total_dim);
+            for (std::size_t i = 0; i < individuals.size(); ++i)
+                {
+                    std::copy(begin(fixation_baseline), end(fixation_baseline),
+                              begin(batch_gvalues) + i * total_dim);
+                    const auto &dip
+                        = pop.diploids[offspring_metadata[individuals[i]].label];
+                    for (auto g : {dip.first, dip.second})
+                        {
+                            const auto &keys = pop.haploid_genomes[g].smutations;
+                            for (auto k : keys)
+                                {
+                                    if (!valid_rows[k])
+                                        {
+                                            throw std::runtime_error(
+                                                "dimensionality mismatch");
+                                        }
+                                }
+                            fwdpy11::accumulate_effect_rows(
+                                effect_matrix.data(), total_dim, keys.data(),
+                                keys.size(), batch_gvalues.data() + i * total_dim);
+                        }
+                }
+            return true;
+        }
+
+        bool
+        can_fold_fixations() const override
+        {
+            return true;
+        }
+
+        void
+        reset_fixation_baseline() override
+        {
+            fixation_baseline.assign(total_dim, 0.0);
+        }
+
+        void
+        fold_fixation(const Mutation &mutation) override
+        {
+            if (mutation.esizes.size() != total_dim)
+                {
+                    throw std::runtime_error("dimensionality mismatch");
+                }
+            for (std::size_t i = 0; i < total_dim; ++i)
+                {
+                    fixation_baseline[i] += 2.0 * mutation.esizes[i];
+                }
+        }
+
+        std::size_t
+        focal_trait() const override
+        {
+            return focal_trait_index;
+        }
+
         void
         update(const fwdpy11::DiploidPopulation & /*pop*/) override
         {
         }
+
+      private:
+        std::vector<double> effect_matrix;
+        std::vector<char> valid_rows;
     };
 } // namespace fwdpy11
 
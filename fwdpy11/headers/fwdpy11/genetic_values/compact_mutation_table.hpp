@@ -0,0 +1,31 @@
+#pragma once
+
+#include <vector>
+
+namespace fwdpy11
+{
+    struct compact_mutation
+    /// The fields of a Mutation that are read by the
+    /// single-deme merge-walk.  A vector of these, indexed
+    /// by mutation key, is much smaller than the mutation
+    /// container, so the random accesses made when comparing
+    /// keys from two genomes mostly hit cache.
+    {
+        double pos;
+        double s;
+        double h;
+    };
+
+    template <typename MutationContainerType>
+    inline void
+    fill_compact_mutation_table(const MutationContainerType &mutations,
+                                std::vector<compact_mutation> &table)
+    {
+        table.resize(mutations.size());
+        for (std::size_t i = 0; i < mutations.size(); ++i)
+            {
+                table[i] = compact_mutation{mutations[i].pos, mutations[i].s,
+                                            mutations[i].h};
+            }
+    }
+}
@@ -2,17 +2,35 @@
 #define FWDPY11_GENETIC_VALUES_WRAPPERS_FWDPP__GVALUE_HPP__
 
 #include <limits>
+#include <stdexcept>
 #include <type_traits>
 #include <functional>
 #include "../DiploidGeneticValue.hpp"
 #include <fwdpy11/genetic_values/site_dependent_genetic_value.hpp>
+#include <fwdpy11/genetic_values/compact_mutation_table.hpp>
 #include <fwdpy11/genetic_value_noise/GeneticValueNoise.hpp>
 
 namespace fwdpy11
 {
+    struct never_clamp
+    {
+        inline bool
+        operator()(const double) const
+        {
+            return false;
+        }
+    };
+
+    struct builtin_genetic_value_model
+    /// Tag type selecting the built-in return value
+    /// and clamping policies of a stateless_site_dependent_genetic_value_wrapper.
+    {
+    };
+
     template <typename single_deme_het_fxn, typename single_deme_hom_fxn,
               typename multi_deme_het_fxn, typename multi_deme_hom_fxn,
-              int starting_value>
+              int starting_value, typename final_trait_fxn,
+              typename final_fitness_fxn, typename fitness_clamp_fxn>
     class stateless_site_dependent_genetic_value_wrapper : public DiploidGeneticValue
     {
       private:
@@ -30,10 +48,10 @@ namespace fwdpy11
             operator()(const fwdpy11::site_dependent_genetic_value& gv,
                        const std::size_t diploid_index,
                        const DiploidMetadata& /*metadata*/,
-                       const DiploidPopulation& pop) const
+                       const DiploidPopulation& pop, const double start) const
             {
                 return gv(pop.diploids[diploid_index], pop.haploid_genomes,
-                          pop.mutations, single_deme_aa, single_deme_Aa, starting_value);
+                          pop.mutations, single_deme_aa, single_deme_Aa, start);
             }
         };
 
@@ -50,7 +68,7 @@ namespace fwdpy11
             inline double
             operator()(const fwdpy11::site_dependent_genetic_value& gv,
                        const std::size_t diploid_index, const DiploidMetadata& metadata,
-                       const DiploidPopulation& pop) const
+                       const DiploidPopulation& pop, const double start) const
             {
                 std::size_t deme = metadata.deme;
                 return gv(
@@ -71,13 +89,13 @@ namespace fwdpy11
                             }
                         return multi_deme_Aa(deme, d, mut);
                     },
-                    starting_value);
+                    start);
             }
         };
 
         using callback_type = std::function<double(
             const fwdpy11::site_dependent_genetic_value&, const std::size_t,
-            const DiploidMetadata&, const DiploidPopulation&)>;
+            const DiploidMetadata&, const DiploidPopulation&, const double)>;
 
         using make_return_value_t = std::function<double(double)>;
 
@@ -91,11 +109,84 @@ namespace fwdpy11
             return multi_deme_callback(aa_scaling);
         }
 
+        static inline void
+        check_deme(std::size_t deme, const Mutation& mut)
+        {
+            if (deme >= mut.esizes.size() || deme >= mut.heffects.size())
+                {
+                    throw std::invalid_argument("deme index is out of range");
+                }
+        }
+
+        template <typename rv_fxn, typename clamp_fxn>
+        void
+        batch_kernel(const DiploidPopulation& pop,
+                     const std::vector<DiploidMetadata>& offspring_metadata,
+                     const std::vector<std::size_t>& individuals,
+                     std::vector<double>& batch_gvalues, const rv_fxn& rv,
+                     const clamp_fxn& clamp)
+        // All policy types are known here, so the merge-walk
+        // is inlined into a single loop over individuals.
+        // With one deme, the walk reads positions and effects
+        // from compact_mutations rather than from pop.mutations.
+        {
+            if (total_dim == 1)
+                {
+                    fill_compact_mutation_table(pop.mutations, compact_mutations);
+                }
+            for (std::size_t i = 0; i < individuals.size(); ++i)
+                {
+                    const auto& md = offspring_metadata[individuals[i]];
+                    const auto& dip = pop.diploids[md.label];
+                    const auto& g1 = pop.haploid_genomes[dip.first].smutations;
+                    const auto& g2 = pop.haploid_genomes[dip.second].smutations;
+                    double& g = batch_gvalues[i * total_dim];
+                    if (total_dim == 1)
+                        {
+                            g = site_dependent_genetic_value_kernel(
+                                g1.cbegin(), g1.cend(), g2.cbegin(), g2.cend(),
+                                compact_mutations, single_deme_aa, single_deme_Aa, rv,
+                                clamp, fixation_baseline[0]);
+                        }
+                    else
+                        {
+                            const std::size_t deme = md.deme;
+                            if (deme >= fixation_baseline.size())
+                                {
+                                    throw std::invalid_argument(
+                                        "deme index is out of range");
+                                }
+                            g = site_dependent_genetic_value_kernel(
+                                g1.cbegin(), g1.cend(), g2.cbegin(), g2.cend(),
+                                pop.mutations,
+                                [deme, this](double& d, const Mutation& mut) {
+                                    check_deme(deme, mut);
+                                    multi_deme_aa(deme, d, mut);
+                                },
+                                [deme, this](double& d, const Mutation& mut) {
+                                    check_deme(deme, mut);
+                                    multi_deme_Aa(deme, d, mut);
+                                },
+                                rv, clamp, fixation_baseline[deme]);
+                        }
+                }
+        }
+
         fwdpy11::site_dependent_genetic_value gv;
         double aa_scaling;
         make_return_value_t make_return_value;
         callback_type callback;
         bool isfitness;
+        // The policies used by calculate_gvalues
+        single_deme_het_fxn single_deme_Aa;
+        single_deme_hom_fxn single_deme_aa;
+        multi_deme_het_fxn multi_deme_Aa;
+        multi_deme_hom_fxn multi_deme_aa;
+        // If true, make_return_value and gv.clamp are the
+        // built-in policies given as template parameters
+        bool builtin_model;
+        // Refilled by each call to batch_kernel
+        std::vector<compact_mutation> compact_mutations;
 
       public:
         stateless_site_dependent_genetic_value_wrapper(
@@ -104,19 +195,110 @@ namespace fwdpy11
             const GeneticValueNoise* noise_)
             : DiploidGeneticValue{ndim, gv2w_, noise_}, gv{clamp}, aa_scaling(scaling),
               make_return_value(std::move(mrv)),
-              callback(init_callback(ndim, aa_scaling)), isfitness(gv2w->isfitness)
+              callback(init_callback(ndim, aa_scaling)), isfitness(gv2w->isfitness),
+              single_deme_Aa(), single_deme_aa(aa_scaling), multi_deme_Aa(),
+              multi_deme_aa(aa_scaling), builtin_model(false), compact_mutations{}
+        {
+            fixation_baseline.assign(total_dim, starting_value);
+        }
+
+        stateless_site_dependent_genetic_value_wrapper(
+            builtin_genetic_value_model, std::size_t ndim, double scaling,
+            const GeneticValueToFitnessMap* gv2w_, const GeneticValueNoise* noise_)
+            : stateless_site_dependent_genetic_value_wrapper(
+                ndim, scaling,
+                (gv2w_ == nullptr || gv2w_->isfitness)
+                    ? make_return_value_t(final_fitness_fxn())
+                    : make_return_value_t(final_trait_fxn()),
+                (gv2w_ == nullptr || gv2w_->isfitness)
+                    ? std::function<bool(double)>(fitness_clamp_fxn())
+                    : std::function<bool(double)>(never_clamp()),
+                gv2w_, noise_)
         {
+            builtin_model = true;
+        }
+
+        bool
+        calculate_gvalues(const GSLrng_t& /*rng*/, const DiploidPopulation& pop,
+                          const std::vector<DiploidMetadata>& offspring_metadata,
+                          const std::vector<std::size_t>& individuals,
+                          std::vector<double>& batch_gvalues) override
+        {
+            if (!builtin_model)
+                {
+                    return false;
+                }
+            batch_gvalues.assign(individuals.size() * total_dim, 0.0);
+            if (isfitness)
+                {
+                    batch_kernel(pop, offspring_metadata, individuals, batch_gvalues,
+                                 final_fitness_fxn(), fitness_clamp_fxn());
+                }
+            else
+                {
+                    batch_kernel(pop, offspring_metadata, individuals, batch_gvalues,
+                                 final_trait_fxn(), never_clamp());
+                }
+            return true;
         }
 
         double
         calculate_gvalue(const DiploidGeneticValueData data) override
         {
+            const auto& md = data.offspring_metadata.get();
+            const double start
+                = total_dim == 1 ? fixation_baseline[0] : fixation_baseline.at(md.deme);
             gvalues[0] = make_return_value(
-                callback(gv, data.offspring_metadata.get().label,
-                         data.offspring_metadata.get(), data.pop.get()));
+                callback(gv, md.label, md, data.pop.get(), start));
             return gvalues[0];
         }
 
+        bool
+        can_fold_fixations() const override
+        {
+            return true;
+        }
+
+        void
+        reset_fixation_baseline() override
+        {
+            fixation_baseline.assign(total_dim, starting_value);
+        }
+
+        void
+        fold_fixation(const Mutation& mutation) override
+        // A fixation is homozygous in every individual in
+        // every deme, so each deme's baseline is updated
+        // by the homozygous policy.  A clamped baseline
+        // is stored as 0.0, which is what the merge-walk
+        // would return for every individual.  Demes for which
+        // the mutation has no effect size are skipped, as
+        // check_deme rejects such genotypes anyway.
+        {
+            if (total_dim == 1)
+                {
+                    single_deme_aa(fixation_baseline[0], mutation);
+                    if (gv.clamp(fixation_baseline[0]))
+                        {
+                            fixation_baseline[0] = 0.0;
+                        }
+                    return;
+                }
+            for (std::size_t deme = 0; deme < total_dim; ++deme)
+                {
+                    if (deme >= mutation.esizes.size()
+                        || deme >= mutation.heffects.size())
+                        {
+                            continue;
+                        }
+                    multi_deme_aa(deme, fixation_baseline[deme], mutation);
+                    if (gv.clamp(fixation_baseline[deme]))
+                        {
+                            fixation_baseline[deme] = 0.0;
+                        }
+                }
+        }
+
         void
         update(const fwdpy11::DiploidPopulation& /*pop*/) override
         {
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+/* Kernels for multivariate genetic values.
+ *
+ * Effect sizes are stored in a row-major matrix with
+ * one row of ndim values per mutation key.
+ * Dimensions 1 through 8 have specialised versions
+ * with fixed-size loops that the compiler can unroll
+ * and vectorise.
+ *
+ * Everything here is inline so that plugins can use
+ * the genetic value types without linking to fwdpy11.
+ */
+
+namespace fwdpy11
+{
+    namespace multivariate_kernels
+    {
+        template <std::size_t ndim>
+        inline void
+        accumulate_fixed(const double *effects, const std::uint32_t *keys,
+                         std::size_t nkeys, double *output)
+        {
+            double sums[ndim];
+            for (std::size_t j = 0; j < ndim; ++j)
+                {
+                    sums[j] = output[j];
+                }
+            for (std::size_t i = 0; i < nkeys; ++i)
+                {
+                    const double *row = effects + keys[i] * ndim;
+                    for (std::size_t j = 0; j < ndim; ++j)
+                        {
+                            sums[j] += row[j];
+                        }
+                }
+            for (std::size_t j = 0; j < ndim; ++j)
+                {
+                    output[j] = sums[j];
+                }
+        }
+
+        inline void
+        accumulate_any(const double *effects, std::size_t ndim,
+                       const std::uint32_t *keys, std::size_t nkeys, double *output)
+        {
+            for (std::size_t i = 0; i < nkeys; ++i)
+                {
+                    const double *row = effects + keys[i] * ndim;
+                    for (std::size_t j = 0; j < ndim; ++j)
+                        {
+                            output[j] += row[j];
+                        }
+                }
+        }
+
+        template <std::size_t ndim>
+        inline double
+        squared_distance_fixed(const double *x, const double *y)
+        {
+            double rv = 0.0;
+            for (std::size_t j = 0; j < ndim; ++j)
+                {
+                    double d = x[j] - y[j];
+                    rv += d * d;
+                }
+            return rv;
+        }
+
+        inline double
+        squared_distance_any(const double *x, const double *y, std::size_t ndim)
+        {
+            double rv = 0.0;
+            for (std::size_t j = 0; j < ndim; ++j)
+                {
+                    double d = x[j] - y[j];
+                    rv += d * d;
+                }
+            return rv;
+        }
+    }
+
+    // Add the rows of effects given by keys[0:nkeys] to output[0:ndim]
+    inline void
+    accumulate_effect_rows(const double *effects, std::size_t ndim,
+                           const std::uint32_t *keys, std::size_t nkeys, double *output)
+    {
+        using namespace multivariate_kernels;
+        switch (ndim)
+            {
+            case 1:
+                accumulate_fixed<1>(effects, keys, nkeys, output);
+                break;
+            case 2:
+                accumulate_fixed<2>(effects, keys, nkeys, output);
+                break;
+            case 3:
+                accumulate_fixed<3>(effects, keys, nkeys, output);
+                break;
+            case 4:
+                accumulate_fixed<4>(effects, keys, nkeys, output);
+                break;
+            case 5:
+                accumulate_fixed<5>(effects, keys, nkeys, output);
+                break;
+            case 6:
+                accumulate_fixed<6>(effects, keys, nkeys, output);
+                break;
+            case 7:
+                accumulate_fixed<7>(effects, keys, nkeys, output);
+                break;
+            case 8:
+                accumulate_fixed<8>(effects, keys, nkeys, output);
+                break;
+            default:
+                accumulate_any(effects, ndim, keys, nkeys, output);
+            }
+    }
+
+    // Returns the squared Euclidean distance between x[0:ndim] and y[0:ndim]
+    inline double
+    squared_distance(const double *x, const double *y, std::size_t ndim)
+    {
+        using namespace multivariate_kernels;
+        switch (ndim)
+            {
+            case 1:
+                return squared_distance_fixed<1>(x, y);
+            case 2:
+                return squared_distance_fixed<2>(x, y);
+            case 3:
+                return squared_distance_fixed<3>(x, y);
+            case 4:
+                return squared_distance_fixed<4>(x, y);
+            case 5:
+                return squared_distance_fixed<5>(x, y);
+            case 6:
+                return squared_distance_fixed<6>(x, y);
+            case 7:
+                return squared_distance_fixed<7>(x, y);
+            case 8:
+                return squared_distance_fixed<8>(x, y);
+            default:
+                return squared_distance_any(x, y, ndim);
+            }
+    }
+
+    // fitness[i] = exp(-d_i / (2 * VW)), where d_i is the squared
+    // distance between row i of gvalues (n x ndim, row-major) and optima.
+    inline void
+    multivariate_gaussian_fitness(const double *gvalues, std::size_t n, std::size_t ndim,
+                                  const double *optima, double VW, double *fitness)
+    {
+        // Two passes let the distance loop run without
+        // calls to exp in its body.
+        for (std::size_t i = 0; i < n; ++i)
+            {
+                fitness[i] = squared_distance(gvalues + i * ndim, optima, ndim);
+            }
+        for (std::size_t i = 0; i < n; ++i)
+            {
+                fitness[i] = std::exp(-fitness[i] / (2.0 * VW));
+            }
+    }
+}
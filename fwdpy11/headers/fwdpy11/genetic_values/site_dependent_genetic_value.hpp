@@ -1,10 +1,100 @@
 #pragma once
 
 #include <fwdpp/type_traits.hpp>
+#include <functional>
 #include <limits>
 
 namespace fwdpy11
 {
+    template <typename iterator_t, typename MutationContainerType,
+              typename updating_policy_hom, typename updating_policy_het,
+              typename make_return_value, typename clamp_function>
+    inline double
+    site_dependent_genetic_value_kernel(
+        iterator_t first1, iterator_t last1, iterator_t first2, iterator_t last2,
+        const MutationContainerType &mutations, const updating_policy_hom &fpol_hom,
+        const updating_policy_het &fpol_het, const make_return_value &rv_function,
+        const clamp_function &clamp, const double starting_value)
+    /*!
+      The merge-walk behind site_dependent_genetic_value.
+      All policies are template parameters, so callers that
+      know their concrete types get a fully inlined loop.
+    */
+    {
+        double w = starting_value;
+        if (first1 == last1 && first2 == last2)
+            return rv_function(w);
+        else if (first1 == last1)
+            {
+                for (; first2 != last2; ++first2)
+                    {
+                        fpol_het(w, mutations[*first2]);
+                        if (clamp(w))
+                            {
+                                return rv_function(0.0);
+                            }
+                    }
+                return rv_function(w);
+            }
+        else if (first2 == last2)
+            {
+                for (; first1 != last1; ++first1)
+                    {
+                        fpol_het(w, mutations[*first1]);
+                        if (clamp(w))
+                            {
+                                return rv_function(0.0);
+                            }
+                    }
+
+                return rv_function(w);
+            }
+        for (; first1 != last1; ++first1)
+            {
+                for (; first2 != last2 && *first1 != *first2
+                       && mutations[*first2].pos < mutations[*first1].pos;
+                     ++first2)
+                    // All mutations in this range are Aa
+                    {
+                        fpol_het(w, mutations[*first2]);
+                        if (clamp(w))
+                            {
+                                return rv_function(0.0);
+                            }
+                    }
+                if (first2 < last2
+                    && (*first1 == *first2
+                        || mutations[*first1].pos == mutations[*first2].pos))
+                    // mutation with index first1 is homozygous
+                    {
+                        fpol_hom(w, mutations[*first1]);
+                        if (clamp(w))
+                            {
+                                return rv_function(0.0);
+                            }
+                        ++first2; // increment so that we don't re-process
+                        // this site as a het next time 'round
+                    }
+                else // mutation first1 is heterozygous
+                    {
+                        fpol_het(w, mutations[*first1]);
+                        if (clamp(w))
+                            {
+                                return rv_function(0.0);
+                            }
+                    }
+            }
+        for (; first2 != last2; ++first2)
+            {
+                fpol_het(w, mutations[*first2]);
+                if (clamp(w))
+                    {
+                        return rv_function(0.0);
+                    }
+            }
+        return rv_function(w);
+    }
+
     struct site_dependent_genetic_value
     {
         std::function<bool(const double)> clamp;
@@ -20,7 +110,7 @@ namespace fwdpy11
                    const updating_policy_hom &fpol_hom,
                    const updating_policy_het &fpol_het,
                    const make_return_value &rv_function,
-                   const double starting_value) const noexcept
+                   const double starting_value) const
         /*!
           Range-based call operator.  Calculates genetic values over ranges of
           mutation keys first1/last1
@@ -64,78 +154,10 @@ namespace fwdpy11
                 "decltype(fpol_het) must be convertible to "
                 "std::function<void(double &,const typename "
                 "MutationContainerType::value_type");
-            result_type w = starting_value;
-            if (first1 == last1 && first2 == last2)
-                return rv_function(w);
-            else if (first1 == last1)
-                {
-                    for (; first2 != last2; ++first2)
-                        {
-                            fpol_het(w, mutations[*first2]);
-                            if (clamp(w))
-                                {
-                                    return rv_function(0.0);
-                                }
-                        }
-                    return rv_function(w);
-                }
-            else if (first2 == last2)
-                {
-                    for (; first1 != last1; ++first1)
-                        {
-                            fpol_het(w, mutations[*first1]);
-                            if (clamp(w))
-                                {
-                                    return rv_function(0.0);
-                                }
-                        }
-
-                    return rv_function(w);
-                }
-            for (; first1 != last1; ++first1)
-                {
-                    for (; first2 != last2 && *first1 != *first2
-                           && mutations[*first2].pos < mutations[*first1].pos;
-                         ++first2)
-                        // All mutations in this range are Aa
-                        {
-                            fpol_het(w, mutations[*first2]);
-                            if (clamp(w))
-                                {
-                                    return rv_function(0.0);
-                                }
-                        }
-                    if (first2 < last2
-                        && (*first1 == *first2
-                            || mutations[*first1].pos == mutations[*first2].pos))
-                        // mutation with index first1 is homozygous
-                        {
-                            fpol_hom(w, mutations[*first1]);
-                            if (clamp(w))
-                                {
-                                    return rv_function(0.0);
-                                }
-                            ++first2; // increment so that we don't re-process
-                            // this site as a het next time 'round
-                        }
-                    else // mutation first1 is heterozygous
-                        {
-                            fpol_het(w, mutations[*first1]);
-                            if (clamp(w))
-                                {
-                                    return rv_function(0.0);
-                                }
-                        }
-                }
-            for (; first2 != last2; ++first2)
-                {
-                    fpol_het(w, mutations[*first2]);
-                    if (clamp(w))
-                        {
-                            return rv_function(0.0);
-                        }
-                }
-            return rv_function(w);
+            return site_dependent_genetic_value_kernel(first1, last1, first2, last2,
+                                                       mutations, fpol_hom, fpol_het,
+                                                       rv_function, clamp,
+                                                       starting_value);
         }
 
         template <typename iterator_t, typename MutationContainerType,
@@ -145,7 +167,7 @@ namespace fwdpy11
                    iterator_t last2, const MutationContainerType &mutations,
                    const updating_policy_hom &fpol_hom,
                    const updating_policy_het &fpol_het,
-                   const double starting_value) const noexcept
+                   const double starting_value) const
         {
             return this->operator()(
                 first1, last1, first2, last2, mutations, fpol_hom, fpol_het,
@@ -161,7 +183,7 @@ namespace fwdpy11
                    const updating_policy_hom &fpol_hom,
                    const updating_policy_het &fpol_het,
                    const make_return_value &rv_function,
-                   const double starting_value) const noexcept
+                   const double starting_value) const
         /*!
           Calculates genetic value for a diploid whose genotype
           across sites is given by haploid_genomes g1 and  g2.
@@ -194,7 +216,7 @@ namespace fwdpy11
                    const MutationContainerType &mutations,
                    const updating_policy_hom &fpol_hom,
                    const updating_policy_het &fpol_het,
-                   const double starting_value) const noexcept
+                   const double starting_value) const
         {
             return this->operator()(
                 g1, g2, mutations, fpol_hom, fpol_het, [](double d) { return d; },
@@ -210,7 +232,7 @@ namespace fwdpy11
                    const updating_policy_hom &fpol_hom,
                    const updating_policy_het &fpol_het,
                    const make_return_value &rv_function,
-                   const double starting_value) const noexcept
+                   const double starting_value) const
         /*!
           Calculates genetic value for a diploid type.
 
@@ -239,7 +261,7 @@ namespace fwdpy11
                    const MutationContainerType &mutations,
                    const updating_policy_hom &fpol_hom,
                    const updating_policy_het &fpol_het,
-                   const double starting_value) const noexcept
+                   const double starting_value) const
         {
             return this->operator()(
                 dip, haploid_genomes, mutations, fpol_hom, fpol_het,
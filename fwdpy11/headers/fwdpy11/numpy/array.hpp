@@ -30,6 +30,18 @@ namespace fwdpy11
         return rv;
     }
 
+    template <typename T>
+    inline pybind11::array_t<T>
+    make_1d_ndarray_readonly(const std::vector<T>& v, pybind11::handle owner)
+    // Returns a readonly 1d numpy array that does not own
+    // its data and that keeps owner alive.
+    {
+        auto rv = pybind11::array_t<T>({ v.size() }, { sizeof(T) }, v.data(),
+                                       owner);
+        rv.attr("flags").attr("writeable") = false;
+        return rv;
+    }
+
     template <typename T>
     inline pybind11::array_t<T>
     make_2d_ndarray(const std::vector<T>& v, std::size_t dim1,
@@ -55,6 +67,20 @@ namespace fwdpy11
         return rv;
     }
 
+    template <typename T>
+    inline pybind11::array_t<T>
+    make_2d_ndarray_readonly(const std::vector<T>& v, std::size_t dim1,
+                             std::size_t dim2, pybind11::handle owner)
+    // Returns a readonly, row-major 2d numpy array that does
+    // not own its data and that keeps owner alive.
+    {
+        auto rv = pybind11::array_t<T>({ dim1, dim2 },
+                                       { dim2 * sizeof(T), sizeof(T) },
+                                       v.data(), owner);
+        rv.attr("flags").attr("writeable") = false;
+        return rv;
+    }
+
     template <typename T>
     inline pybind11::array_t<T>
     make_1d_array_with_capsule(std::vector<T>&& v)
@@ -22,6 +22,7 @@
 #ifndef FWDPY11_SERIALIZATION_HPP
 #define FWDPY11_SERIALIZATION_HPP
 
+#include <cstdint>
 #include <string>
 #include <stdexcept>
 #include <numeric>
@@ -51,7 +52,17 @@ namespace fwdpy11
             // Changed to 6 in 0.6.3 because we removed "ancient sample
             // records" that weren't being used and we changed the C++
             // constructor for Mutation.
-            return 6;
+            // Changed to 7 in 0.25.0 to record the size of
+            // fwdpp::ts::table_index_t, which determines the
+            // binary layout of node ids in metadata and tables,
+            // and the number of folded selected fixations.
+            return 7;
+        }
+
+        inline constexpr std::uint32_t
+        table_index_size()
+        {
+            return static_cast<std::uint32_t>(sizeof(fwdpp::ts::table_index_t));
         }
 
         template <typename streamtype, typename poptype>
@@ -61,6 +72,9 @@ namespace fwdpy11
             buffer << "fp11";
             auto m = magic();
             buffer.write(reinterpret_cast<char *>(&m), sizeof(decltype(m)));
+            auto index_size = table_index_size();
+            buffer.write(reinterpret_cast<char *>(&index_size),
+                         sizeof(decltype(index_size)));
             buffer.write(reinterpret_cast<const char *>((&pop->generation)),
                          sizeof(unsigned));
             fwdpy11::serialize_diploid_metadata()(buffer, pop->diploid_metadata);
@@ -96,6 +110,8 @@ namespace fwdpy11
                 {
                     w(buffer, pop->ancient_sample_genetic_value_matrix.data(), msize);
                 }
+            // Added in file version 7
+            w(buffer, &pop->num_folded_fixations);
 
             return buffer;
         }
@@ -128,6 +144,21 @@ namespace fwdpy11
                                                  "was last supported in "
                                                  "fwdpy11 0.1.4");
                     }
+                // Files prior to version 7 always used 32 bit node ids
+                std::uint32_t index_size = sizeof(std::int32_t);
+                if (version >= 7)
+                    {
+                        buffer.read(reinterpret_cast<char *>(&index_size),
+                                    sizeof(std::uint32_t));
+                    }
+                if (index_size != table_index_size())
+                    {
+                        throw std::runtime_error(
+                            "File format incompatibility: the file uses "
+                            + std::to_string(8 * index_size)
+                            + " bit table row ids but this build of fwdpy11 uses "
+                            + std::to_string(8 * table_index_size()) + " bit ids");
+                    }
                 buffer.read(reinterpret_cast<char *>(&pop.generation), sizeof(unsigned));
                 deserialize_diploid_metadata()(buffer, pop.diploid_metadata);
                 deserialize_diploid_metadata()(buffer, pop.ancient_sample_metadata);
@@ -202,6 +233,11 @@ namespace fwdpy11
                                   msize);
                             }
                     }
+                pop.num_folded_fixations = 0;
+                if (version >= 7)
+                    {
+                        r(buffer, &pop.num_folded_fixations);
+                    }
                 pop.rebuild_mutation_lookup(false);
                 return buffer;
             }
@@ -45,7 +45,7 @@ namespace fwdpy11
         std::size_t parents[2]; // Indexes of parents
         std::int32_t deme;
         std::int32_t sex;
-        std::int32_t nodes[2]; // Nodes in TreeSequence
+        fwdpp::ts::table_index_t nodes[2]; // Nodes in TreeSequence
     };
 
     inline bool
@@ -7,6 +7,9 @@
 #include <iostream>
 #include <stdexcept>
 #include <limits>
+#include <vector>
+#include <iterator>
+#include <algorithm>
 #include <unordered_set>
 #include <fwdpp/poptypes/tags.hpp>
 #include <fwdpp/ts/table_collection_functions.hpp>
@@ -20,6 +23,67 @@ namespace fwdpy11
     class DiploidPopulation : public Population
     {
       private:
+        // Sorted copy of preserved_sample_nodes.  During a simulation,
+        // this index is remapped after each simplification and only
+        // the ancient samples recorded since the last call to
+        // fill_preserved_nodes are checked against it.
+        std::vector<fwdpp::ts::table_index_t> preserved_node_index;
+        // Number of leading elements of ancient_sample_metadata
+        // whose nodes are in preserved_sample_nodes.
+        std::size_t num_indexed_ancient_samples;
+
+        void
+        update_preserved_node_index()
+        {
+            if (num_indexed_ancient_samples == ancient_sample_metadata.size())
+                {
+                    return;
+                }
+            std::vector<fwdpp::ts::table_index_t> new_nodes;
+            for (auto md = begin(ancient_sample_metadata) + num_indexed_ancient_samples;
+                 md < end(ancient_sample_metadata); ++md)
+                {
+                    for (auto i : md->nodes)
+                        {
+                            if (!std::binary_search(begin(preserved_node_index),
+                                                    end(preserved_node_index), i))
+                                {
+                                    new_nodes.push_back(i);
+                                }
+                        }
+                }
+            num_indexed_ancient_samples = ancient_sample_metadata.size();
+            if (new_nodes.empty())
+                {
+                    return;
+                }
+            auto nold = preserved_node_index.size();
+            preserved_node_index.insert(end(preserved_node_index), begin(new_nodes),
+                                        end(new_nodes));
+            auto first_new = begin(preserved_node_index) + nold;
+            std::sort(first_new, end(preserved_node_index));
+            preserved_node_index.erase(std::unique(first_new, end(preserved_node_index)),
+                                       end(preserved_node_index));
+            // Append the new nodes in the order in which they were recorded,
+            // skipping duplicates within the new batch.
+            first_new = begin(preserved_node_index) + nold;
+            std::vector<char> appended(
+                std::distance(first_new, end(preserved_node_index)), 0);
+            for (auto i : new_nodes)
+                {
+                    auto offset = std::distance(
+                        first_new, std::lower_bound(first_new,
+                                                    end(preserved_node_index), i));
+                    if (!appended[offset])
+                        {
+                            preserved_sample_nodes.push_back(i);
+                            appended[offset] = 1;
+                        }
+                }
+            std::inplace_merge(begin(preserved_node_index), first_new,
+                               end(preserved_node_index));
+        }
+
         void
         fill_sample_nodes_from_metadata(
             std::vector<fwdpp::ts::table_index_t> &n,
@@ -111,7 +175,8 @@ namespace fwdpy11
 
         // Constructors for Python
         DiploidPopulation(const fwdpp::uint_t N, const double length)
-            : Population{2, N, length}, diploids(N, {0, 0}),
+            : Population{2, N, length}, preserved_node_index{},
+              num_indexed_ancient_samples{0}, diploids(N, {0, 0}),
               diploid_metadata(N), ancient_sample_metadata{}
         {
             finish_construction({N});
@@ -121,6 +186,7 @@ namespace fwdpy11
                           const double length)
             : Population{2, std::accumulate(begin(deme_sizes), end(deme_sizes), 0u),
                          length},
+              preserved_node_index{}, num_indexed_ancient_samples{0},
               diploids(std::accumulate(begin(deme_sizes), end(deme_sizes), 0u), {0, 0}),
               diploid_metadata(N), ancient_sample_metadata{}
         {
@@ -157,9 +223,45 @@ namespace fwdpy11
 
         void
         fill_preserved_nodes() override
+        // When not simulating, the preserved nodes are rebuilt from
+        // scratch because the metadata and tables may have been
+        // modified arbitrarily.  During a simulation, only the ancient
+        // samples recorded since the previous call are processed.
         {
-            fill_sample_nodes_from_metadata(preserved_sample_nodes,
-                                            ancient_sample_metadata);
+            if (!is_simulating
+                || num_indexed_ancient_samples > ancient_sample_metadata.size())
+                {
+                    reset_preserved_node_index();
+                }
+            update_preserved_node_index();
+        }
+
+        void
+        reset_preserved_node_index()
+        // Must be called whenever ancient_sample_metadata
+        // is modified by anything other than record_ancient_samples
+        // during a simulation.
+        {
+            preserved_sample_nodes.clear();
+            preserved_node_index.clear();
+            num_indexed_ancient_samples = 0;
+        }
+
+        void
+        remap_preserved_nodes(const std::vector<fwdpp::ts::table_index_t> &idmap)
+        // Apply the output of simplification to the preserved nodes.
+        {
+            const auto remap = [&idmap](fwdpp::ts::table_index_t i) { return idmap[i]; };
+            std::transform(begin(preserved_sample_nodes), end(preserved_sample_nodes),
+                           begin(preserved_sample_nodes), remap);
+            std::transform(begin(preserved_node_index), end(preserved_node_index),
+                           begin(preserved_node_index), remap);
+            // Simplification assigns consecutive ids to samples
+            // in input order, so this sort is rarely needed.
+            if (!std::is_sorted(begin(preserved_node_index), end(preserved_node_index)))
+                {
+                    std::sort(begin(preserved_node_index), end(preserved_node_index));
+                }
         }
 
         virtual std::size_t
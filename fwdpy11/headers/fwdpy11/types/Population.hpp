@@ -2,6 +2,7 @@
 #define FWDPY11_POPULATION_HPP__
 
 #include <tuple>
+#include <cstdint>
 #include <algorithm>
 #include <stdexcept>
 #include <gsl/gsl_randist.h>
@@ -69,10 +70,16 @@ namespace fwdpy11
         // represent a matrix of N rows by "dimensions" columns.
         std::vector<double> genetic_value_matrix, ancient_sample_genetic_value_matrix;
 
+        // The number of selected fixations removed from genomes
+        // after being folded into the fixation baseline of the
+        // genetic value objects.  See DiploidGeneticValue.
+        std::uint64_t num_folded_fixations;
+
         Population(fwdpp::uint_t ploidy, fwdpp::uint_t N_, const double L)
             : fwdpp_base{ploidy * N_}, N{N_}, generation{0}, is_simulating{false},
               tables(init_tables(N_, L)), alive_nodes{}, preserved_sample_nodes{},
-              genetic_value_matrix{}, ancient_sample_genetic_value_matrix{}
+              genetic_value_matrix{}, ancient_sample_genetic_value_matrix{},
+              num_folded_fixations{0}
         {
         }
 
@@ -159,7 +166,8 @@ namespace fwdpy11
             return this->is_equal(rhs) && tables_equal(rhs)
                    && this->genetic_value_matrix == rhs.genetic_value_matrix
                    && this->ancient_sample_genetic_value_matrix
-                          == rhs.ancient_sample_genetic_value_matrix;
+                          == rhs.ancient_sample_genetic_value_matrix
+                   && this->num_folded_fixations == rhs.num_folded_fixations;
         }
 
         virtual std::size_t ancient_sample_metadata_size() const = 0;
@@ -0,0 +1,30 @@
+"""
+Summary statistics computed directly from a
+:class:`fwdpy11.TableCollection` or from genotype data.
+
+These functions do not require exporting the tables to ``tskit``,
+and are fast enough to call from time series recorders.
+
+.. versionadded:: 0.25.0
+"""
+
+from ._association_scan import AssociationScan, association_scan  # NOQA
+from ._haplotype_statistics import (  # NOQA
+    HaplotypeScan,
+    ehh_decay,
+    haplotype_scan,
+    standardize_by_allele_count,
+)
+from ._ibd_segments import IBDSegments, ibd_segments  # NOQA
+from ._linkage_disequilibrium import (  # NOQA
+    LinkageDisequilibrium,
+    linkage_disequilibrium,
+)
+from ._tree_statistics import (  # NOQA
+    allele_frequency_spectrum,
+    divergence,
+    diversity,
+    fst,
+    segregating_sites,
+    tajimas_d,
+)
@@ -0,0 +1,115 @@
+from typing import List, NamedTuple, Optional, Union
+
+import numpy as np
+
+from .._fwdpy11 import _association_scan
+from .._types import TableCollection
+
+
+class AssociationScan(NamedTuple):
+    """
+    Single-marker association tests, with one entry per variant.
+
+    :param positions: Position of each variant
+    :type positions: numpy.ndarray
+    :param keys: Mutation key of each variant
+    :type keys: numpy.ndarray
+    :param derived_counts: Number of copies of the derived allele in the sample
+    :type derived_counts: numpy.ndarray
+    :param beta: Estimated effect of one copy of the derived allele
+    :type beta: numpy.ndarray
+    :param se: Standard error of `beta`
+    :type se: numpy.ndarray
+    :param pvalue: Two-sided p-value
+    :type pvalue: numpy.ndarray
+
+    .. versionadded:: 0.25.0
+    """
+
+    positions: np.ndarray
+    keys: np.ndarray
+    derived_counts: np.ndarray
+    beta: np.ndarray
+    se: np.ndarray
+    pvalue: np.ndarray
+
+
+def association_scan(
+    tables: TableCollection,
+    samples: Union[List[int], np.ndarray],
+    phenotypes: Union[List[float], np.ndarray],
+    *,
+    covariates: Optional[np.ndarray] = None,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+    sites_per_chunk: int = 1000,
+    num_threads: int = 1,
+) -> AssociationScan:
+    """
+    Regress a phenotype on the dosage of each variant.
+
+    :param tables: A table collection
+    :type tables: :class:`fwdpy11.TableCollection`
+    :param samples: Sample nodes, two per individual
+    :type samples: list or numpy.ndarray
+    :param phenotypes: One phenotype per individual
+    :type phenotypes: list or numpy.ndarray
+    :param covariates: (None) Covariates, with one row per individual
+    :type covariates: numpy.ndarray
+    :param record_neutral: (True) Test neutral variants
+    :type record_neutral: bool
+    :param record_selected: (True) Test selected variants
+    :type record_selected: bool
+    :param sites_per_chunk: (1000) Number of sites whose
+                            genotypes are held in memory at once
+                            by each thread
+    :type sites_per_chunk: int
+    :param num_threads: (1) Number of threads
+    :type num_threads: int
+
+    :rtype: :class:`fwdpy11.statistics.AssociationScan`
+
+    Nodes ``samples[2 * i]`` and ``samples[2 * i + 1]`` are the
+    genomes of individual ``i``.  For a population, these
+    are given by :attr:`fwdpy11.DiploidPopulation.alive_nodes`,
+    and the phenotypes could be
+    ``[md.g + md.e for md in pop.diploid_metadata]``.
+
+    Each variant is tested using the linear model
+    ``phenotype ~ 1 + covariates + dosage``, where dosage is
+    the number of copies of the derived allele.  The p-value is
+    from a t distribution.  Collinear covariates are dropped.
+    Variants whose dosage is explained by the covariates have
+    ``nan`` estimates.
+
+    Genotypes are generated from the trees in chunks of sites, so
+    memory does not grow with the number of variants.
+    The phenotype is adjusted for the covariates once, after which
+    each test only visits the individuals carrying the derived allele.
+
+    .. versionadded:: 0.25.0
+    """
+    y = np.asarray(phenotypes, dtype=np.float64)
+    if y.ndim != 1:
+        raise ValueError("phenotypes must be one-dimensional")
+    if covariates is None:
+        c = np.zeros((len(y), 0))
+    else:
+        c = np.asarray(covariates, dtype=np.float64)
+        if c.ndim == 1:
+            c = c.reshape(-1, 1)
+        if c.ndim != 2 or c.shape[0] != len(y):
+            raise ValueError("covariates must have one row per individual")
+    return AssociationScan(
+        *_association_scan(
+            tables,
+            samples,
+            y,
+            c.ravel(),
+            c.shape[1],
+            record_neutral,
+            record_selected,
+            sites_per_chunk,
+            num_threads,
+        )
+    )
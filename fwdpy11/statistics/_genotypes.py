@@ -0,0 +1,40 @@
+from typing import List, Optional, Union
+
+import numpy as np
+
+from .._fwdpy11 import PackedDataMatrix, _packed_data_matrix_from_tables
+from .._types import DataMatrix, TableCollection
+
+GenotypeData = Union[DataMatrix, PackedDataMatrix, TableCollection]
+Samples = Optional[Union[List[int], np.ndarray]]
+
+
+def _genotype_data(
+    data: GenotypeData,
+    samples: Samples,
+    begin: float,
+    end: Optional[float],
+    record_neutral: bool,
+    record_selected: bool,
+) -> Union[DataMatrix, PackedDataMatrix]:
+    """
+    Tables are converted to haplotype-packed genotypes
+    for the samples in [begin, end).  Other inputs are
+    returned as they are.
+    """
+    if not isinstance(data, TableCollection):
+        return data
+    if samples is None:
+        raise ValueError("samples are required for a table collection")
+    if end is None:
+        end = data.genome_length
+    return _packed_data_matrix_from_tables(
+        data,
+        samples,
+        record_neutral,
+        record_selected,
+        False,
+        begin,
+        end,
+        "haplotype",
+    )
@@ -0,0 +1,187 @@
+from typing import NamedTuple, Optional, Tuple
+
+import numpy as np
+
+from .._fwdpy11 import _ehh_decay, _haplotype_scan
+from ._genotypes import GenotypeData, Samples, _genotype_data
+
+
+class HaplotypeScan(NamedTuple):
+    """
+    Haplotype homozygosity scores, with one entry per core site.
+
+    :param positions: Position of each site
+    :type positions: numpy.ndarray
+    :param keys: Mutation key of each site
+    :type keys: numpy.ndarray
+    :param derived_counts: Number of copies of the derived allele
+    :type derived_counts: numpy.ndarray
+    :param ihh_ancestral: iHH of the ancestral allele
+    :type ihh_ancestral: numpy.ndarray
+    :param ihh_derived: iHH of the derived allele
+    :type ihh_derived: numpy.ndarray
+    :param ihs: Unstandardised iHS
+    :type ihs: numpy.ndarray
+    :param sl_ancestral: SL of the ancestral allele
+    :type sl_ancestral: numpy.ndarray
+    :param sl_derived: SL of the derived allele
+    :type sl_derived: numpy.ndarray
+    :param nsl: Unstandardised nSL
+    :type nsl: numpy.ndarray
+
+    .. versionadded:: 0.25.0
+    """
+
+    positions: np.ndarray
+    keys: np.ndarray
+    derived_counts: np.ndarray
+    ihh_ancestral: np.ndarray
+    ihh_derived: np.ndarray
+    ihs: np.ndarray
+    sl_ancestral: np.ndarray
+    sl_derived: np.ndarray
+    nsl: np.ndarray
+
+
+def haplotype_scan(
+    data: GenotypeData,
+    samples: Samples = None,
+    *,
+    begin: float = 0.0,
+    end: Optional[float] = None,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+    min_ehh: float = 0.05,
+    min_maf: float = 0.05,
+    include_edges: bool = False,
+    num_threads: int = 1,
+) -> HaplotypeScan:
+    """
+    iHS and nSL with every variable site as the core site.
+
+    :param data: The genotypes
+    :type data: :class:`fwdpy11.DataMatrix` or :class:`fwdpy11.PackedDataMatrix`
+                or :class:`fwdpy11.TableCollection`
+    :param samples: (None) Sample nodes.  Required if `data` is a
+                    table collection, and ignored otherwise.
+    :type samples: list or numpy.ndarray
+    :param min_ehh: (0.05) Stop integrating EHH once it falls to this value
+    :type min_ehh: float
+    :param min_maf: (0.05) Core sites with a lower minor allele
+                    frequency are not scored
+    :type min_maf: float
+    :param include_edges: (False) If False, iHH is ``nan`` when
+                          EHH does not fall to `min_ehh` before the
+                          first or last site
+    :type include_edges: bool
+    :param num_threads: (1) Number of threads
+    :type num_threads: int
+
+    :rtype: :class:`fwdpy11.statistics.HaplotypeScan`
+
+    The remaining parameters are as for
+    :func:`fwdpy11.statistics.linkage_disequilibrium`.
+
+    For each allele at a core site, EHH is the fraction of pairs
+    of haplotypes carrying that allele that are identical from the core
+    to another site.  iHH integrates EHH over distance on both sides of
+    the core, and :math:`iHS = \\ln(iHH_{ancestral} / iHH_{derived})`
+    (Voight et al. 2006).  SL is the mean number of consecutive sites,
+    counting the core once, over which pairs of haplotypes
+    are identical, and :math:`nSL = \\ln(SL_{ancestral} / SL_{derived})`
+    (Ferrer-Admetlla et al. 2014).  Negative scores mean that
+    haplotypes carrying the derived allele are unusually long.
+
+    The scores are not standardised.
+    See :func:`fwdpy11.statistics.standardize_by_allele_count`.
+    Core sites where either allele is present in fewer than two
+    haplotypes have ``nan`` scores.
+
+    Haplotypes are groups of columns stored as bit masks,
+    which are split at each site by the bit-packed genotypes.
+    Core sites are processed in parallel.
+
+    .. versionadded:: 0.25.0
+    """
+    data = _genotype_data(data, samples, begin, end, record_neutral, record_selected)
+    return HaplotypeScan(
+        *_haplotype_scan(
+            data,
+            record_neutral,
+            record_selected,
+            min_ehh,
+            min_maf,
+            include_edges,
+            num_threads,
+        )
+    )
+
+
+def ehh_decay(
+    data: GenotypeData,
+    core: int,
+    samples: Samples = None,
+    *,
+    begin: float = 0.0,
+    end: Optional[float] = None,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+) -> Tuple[np.ndarray, np.ndarray, np.ndarray]:
+    """
+    EHH of each allele at one core site.
+
+    :param core: Index of the core site
+    :type core: int
+
+    :returns: The positions of the sites and the EHH of the
+              ancestral and derived alleles at each site.
+    :rtype: tuple
+
+    The remaining parameters are as for
+    :func:`fwdpy11.statistics.haplotype_scan`.
+    The EHH of an allele present in fewer than two
+    haplotypes is ``nan``.
+
+    .. versionadded:: 0.25.0
+    """
+    data = _genotype_data(data, samples, begin, end, record_neutral, record_selected)
+    return _ehh_decay(data, record_neutral, record_selected, core)
+
+
+def standardize_by_allele_count(
+    score: np.ndarray, derived_counts: np.ndarray, nbins: int = 20
+) -> np.ndarray:
+    """
+    Standardise scores within bins of derived allele count.
+
+    :param score: Unstandardised scores, such as iHS or nSL
+    :type score: numpy.ndarray
+    :param derived_counts: Derived allele count of each site
+    :type derived_counts: numpy.ndarray
+    :param nbins: (20) Number of bins of equal width
+    :type nbins: int
+
+    :rtype: numpy.ndarray
+
+    Within each bin, the mean is subtracted and the result is
+    divided by the standard deviation, ignoring ``nan`` values.
+
+    .. versionadded:: 0.25.0
+    """
+    score = np.asarray(score, dtype=np.float64)
+    counts = np.asarray(derived_counts)
+    if len(score) != len(counts):
+        raise ValueError("score and derived_counts must have the same length")
+    rv = np.full(len(score), np.nan)
+    valid = ~np.isnan(score)
+    if not np.any(valid):
+        return rv
+    edges = np.linspace(counts[valid].min(), counts[valid].max() + 1, nbins + 1)
+    bins = np.digitize(counts, edges)
+    for b in np.unique(bins[valid]):
+        idx = valid & (bins == b)
+        s = score[idx]
+        sd = s.std()
+        if sd > 0.0:
+            rv[idx] = (s - s.mean()) / sd
+    return rv
@@ -0,0 +1,99 @@
+from typing import List, NamedTuple, Optional, Tuple, Union
+
+import numpy as np
+
+from .._fwdpy11 import _ibd_segments
+from .._types import TableCollection
+
+
+class IBDSegments(NamedTuple):
+    """
+    Identity-by-descent segments, with one entry per segment.
+
+    :param first: The first sample node of each pair
+    :type first: numpy.ndarray
+    :param second: The second sample node of each pair
+    :type second: numpy.ndarray
+    :param left: Left end of each segment
+    :type left: numpy.ndarray
+    :param right: Right end of each segment
+    :type right: numpy.ndarray
+    :param node: The most recent common ancestor
+    :type node: numpy.ndarray
+    :param time: Birth time of `node`
+    :type time: numpy.ndarray
+
+    Segments are half-open intervals, ``[left, right)``, and
+    ``first < second``.
+
+    .. versionadded:: 0.25.0
+    """
+
+    first: np.ndarray
+    second: np.ndarray
+    left: np.ndarray
+    right: np.ndarray
+    node: np.ndarray
+    time: np.ndarray
+
+    @property
+    def length(self) -> np.ndarray:
+        """
+        Length of each segment
+        """
+        return self.right - self.left
+
+
+def ibd_segments(
+    tables: TableCollection,
+    samples: Optional[Union[List[int], np.ndarray]] = None,
+    *,
+    pairs: Optional[List[Tuple[int, int]]] = None,
+    min_length: float = 0.0,
+) -> IBDSegments:
+    """
+    Find the segments that pairs of sample nodes inherit
+    from the same common ancestor.
+
+    :param tables: A table collection
+    :type tables: :class:`fwdpy11.TableCollection`
+    :param samples: (None) Sample nodes.  All pairs of these
+                    nodes are considered.
+    :type samples: list or numpy.ndarray
+    :param pairs: (None) Pairs of sample nodes to consider
+    :type pairs: list[tuple]
+    :param min_length: (0.0) Segments shorter than this are not reported
+    :type min_length: float
+
+    :rtype: :class:`fwdpy11.statistics.IBDSegments`
+
+    Exactly one of `samples` and `pairs` must be given.
+
+    A segment is a maximal interval of the genome over which
+    the two nodes have the same most recent common ancestor (MRCA).
+    Neighbouring trees therefore contribute to the same segment
+    when the MRCA does not change between them.
+    The MRCA may be one of the two nodes, for example when
+    ancient samples are included.
+
+    The tables are processed from the youngest parents to the
+    oldest, and each node only holds the parts of the genome that
+    it inherits from the samples.  A node's ancestry is released
+    once all of its parents are processed, so memory is
+    bounded by the lineages present at one time plus the output.
+    Using `pairs` or a large `min_length` reduces the size of the
+    output for large sample sizes, as the number of pairs is
+    quadratic in the number of samples.
+
+    .. versionadded:: 0.25.0
+    """
+    if (samples is None) == (pairs is None):
+        raise ValueError("exactly one of samples and pairs must be given")
+    if pairs is not None:
+        p = [(int(i), int(j)) for i, j in pairs]
+        if len(p) == 0:
+            raise ValueError("pairs must not be empty")
+        return IBDSegments(*_ibd_segments(tables, [], p, min_length))
+    return IBDSegments(
+        *_ibd_segments(tables, [int(i) for i in samples], [], min_length)
+    )
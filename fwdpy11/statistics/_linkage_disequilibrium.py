@@ -0,0 +1,137 @@
+from typing import NamedTuple, Optional
+
+import numpy as np
+
+from .._fwdpy11 import _linkage_disequilibrium
+from ._genotypes import GenotypeData, Samples, _genotype_data
+
+
+class LinkageDisequilibrium(NamedTuple):
+    """
+    Linkage disequilibrium between pairs of sites.
+
+    :param positions: Position of each site
+    :type positions: numpy.ndarray
+    :param keys: Mutation key of each site
+    :type keys: numpy.ndarray
+    :param first: Index of the first site of each pair
+    :type first: numpy.ndarray
+    :param second: Index of the second site of each pair
+    :type second: numpy.ndarray
+    :param D: :math:`D` for each pair
+    :type D: numpy.ndarray
+    :param r2: :math:`r^2` for each pair
+    :type r2: numpy.ndarray
+    :param D_prime: :math:`D'` for each pair
+    :type D_prime: numpy.ndarray
+
+    Pairs are sorted by `first` and then by `second`,
+    and ``first < second``.
+
+    .. versionadded:: 0.25.0
+    """
+
+    positions: np.ndarray
+    keys: np.ndarray
+    first: np.ndarray
+    second: np.ndarray
+    D: np.ndarray
+    r2: np.ndarray
+    D_prime: np.ndarray
+
+    def matrix(self, statistic: str = "r2") -> np.ndarray:
+        """
+        Return one statistic as a symmetric matrix.
+
+        :param statistic: ("r2") One of ``"D"``, ``"r2"`` or ``"D_prime"``
+        :type statistic: str
+
+        :rtype: numpy.ndarray
+
+        Entries for pairs that were not computed,
+        and the diagonal, are ``nan``.
+        """
+        values = getattr(self, statistic)
+        n = len(self.positions)
+        rv = np.full((n, n), np.nan)
+        rv[self.first, self.second] = values
+        rv[self.second, self.first] = values
+        return rv
+
+
+def linkage_disequilibrium(
+    data: GenotypeData,
+    samples: Samples = None,
+    *,
+    begin: float = 0.0,
+    end: Optional[float] = None,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+    max_sites_apart: Optional[int] = None,
+    max_distance: Optional[float] = None,
+    num_threads: int = 1,
+) -> LinkageDisequilibrium:
+    """
+    Pairwise linkage disequilibrium between variable sites.
+
+    :param data: The genotypes
+    :type data: :class:`fwdpy11.DataMatrix` or :class:`fwdpy11.PackedDataMatrix`
+                or :class:`fwdpy11.TableCollection`
+    :param samples: (None) Sample nodes.  Required if `data` is a
+                    table collection, and ignored otherwise.
+    :type samples: list or numpy.ndarray
+    :param begin: (0.0) For a table collection, the start of the region
+    :type begin: float
+    :param end: (None) For a table collection, the end of the region.
+                The default is the end of the genome.
+    :type end: float
+    :param record_neutral: (True) Include neutral variants
+    :type record_neutral: bool
+    :param record_selected: (True) Include selected variants
+    :type record_selected: bool
+    :param max_sites_apart: (None) Only include pairs of sites at most
+                            this many sites apart
+    :type max_sites_apart: int
+    :param max_distance: (None) Only include pairs of sites at most
+                         this far apart
+    :type max_distance: float
+    :param num_threads: (1) Number of threads
+    :type num_threads: int
+
+    :rtype: :class:`fwdpy11.statistics.LinkageDisequilibrium`
+
+    Neutral and selected variants are combined in order
+    of position.  The genotypes are packed into one bit per
+    haplotype, and the haplotype counts for a pair of sites
+    come from popcounts of the AND of their rows.
+    A :class:`fwdpy11.PackedDataMatrix` must have ``"haplotype"``
+    packing.
+
+    Without `max_sites_apart` or `max_distance`, all pairs
+    are returned, which takes memory quadratic in the
+    number of sites.
+
+    :math:`D'` is signed.  :math:`r^2` and :math:`D'` are ``nan``
+    for pairs involving a site that is not variable in the sample.
+
+    .. versionadded:: 0.25.0
+    """
+    if max_sites_apart is not None and max_sites_apart < 1:
+        raise ValueError("max_sites_apart must be >= 1")
+    if max_distance is not None and not max_distance >= 0.0:
+        raise ValueError("max_distance must be >= 0")
+    data = _genotype_data(data, samples, begin, end, record_neutral, record_selected)
+    if max_sites_apart is None:
+        max_sites_apart = int(np.iinfo(np.uint64).max)
+    if max_distance is None:
+        max_distance = np.inf
+    return LinkageDisequilibrium(
+        *_linkage_disequilibrium(
+            data,
+            record_neutral,
+            record_selected,
+            max_sites_apart,
+            max_distance,
+            num_threads,
+        )
+    )
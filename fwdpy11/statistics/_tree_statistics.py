@@ -0,0 +1,312 @@
+import itertools
+from typing import List, Optional, Sequence, Tuple, Union
+
+import numpy as np
+
+from .._fwdpy11 import _tree_statistic
+from .._types import TableCollection
+
+SampleSets = Sequence[Union[List[int], np.ndarray]]
+Windows = Optional[Union[List[float], np.ndarray]]
+Indexes = Optional[List[Tuple[int, int]]]
+
+
+def _windows(tables: TableCollection, windows: Windows) -> List[float]:
+    if windows is None:
+        return [0.0, tables.genome_length]
+    return [float(i) for i in windows]
+
+
+def _compute(
+    tables: TableCollection,
+    sample_sets: SampleSets,
+    windows: Windows,
+    statistic: str,
+    mode: str,
+    polarised: bool,
+    span_normalise: bool,
+    record_neutral: bool,
+    record_selected: bool,
+    indexes: List[Tuple[int, int]],
+) -> np.ndarray:
+    rv = _tree_statistic(
+        tables,
+        [[int(u) for u in s] for s in sample_sets],
+        _windows(tables, windows),
+        statistic,
+        mode,
+        polarised,
+        span_normalise,
+        record_neutral,
+        record_selected,
+        indexes,
+    )
+    if windows is None:
+        return rv[0]
+    return rv
+
+
+def _all_pairs(sample_sets: SampleSets, indexes: Indexes) -> List[Tuple[int, int]]:
+    if indexes is None:
+        return list(itertools.combinations(range(len(sample_sets)), 2))
+    return [(int(i), int(j)) for i, j in indexes]
+
+
+def diversity(
+    tables: TableCollection,
+    sample_sets: SampleSets,
+    *,
+    windows: Windows = None,
+    mode: str = "site",
+    span_normalise: bool = True,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+) -> np.ndarray:
+    """
+    Mean number of pairwise differences within each sample set.
+
+    :param tables: A table collection
+    :type tables: :class:`fwdpy11.TableCollection`
+    :param sample_sets: Lists of sample nodes
+    :type sample_sets: list
+    :param windows: (None) Window breakpoints
+    :type windows: list or numpy.ndarray
+    :param mode: ("site") Either ``"site"`` or ``"branch"``
+    :type mode: str
+    :param span_normalise: (True) If True, divide by the length of each window
+    :type span_normalise: bool
+    :param record_neutral: (True) Site mode: include neutral mutations
+    :type record_neutral: bool
+    :param record_selected: (True) Site mode: include selected mutations
+    :type record_selected: bool
+
+    :returns: One value per window and sample set
+    :rtype: numpy.ndarray
+
+    Window ``i`` is ``[windows[i], windows[i + 1])``.
+    If `windows` is None, the whole genome is one window and the
+    window dimension is dropped from the output.
+
+    In site mode, each mutation in the mutation table is a
+    variant.  In branch mode, the result is the expected value
+    given the trees, with branch lengths in generations.
+
+    The trees are visited once, however many sample sets and
+    windows there are.  The tables do not need to be indexed,
+    but indexes are used when present.
+
+    .. versionadded:: 0.25.0
+    """
+    return _compute(
+        tables,
+        sample_sets,
+        windows,
+        "diversity",
+        mode,
+        True,
+        span_normalise,
+        record_neutral,
+        record_selected,
+        [],
+    )
+
+
+def divergence(
+    tables: TableCollection,
+    sample_sets: SampleSets,
+    indexes: Indexes = None,
+    *,
+    windows: Windows = None,
+    mode: str = "site",
+    span_normalise: bool = True,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+) -> np.ndarray:
+    """
+    Mean number of differences between nodes from two sample sets.
+
+    :param indexes: (None) Pairs of indexes into `sample_sets`.
+                    The default is all pairs.
+    :type indexes: list[tuple]
+
+    :returns: One value per window and pair of sample sets
+    :rtype: numpy.ndarray
+
+    The remaining parameters are as for
+    :func:`fwdpy11.statistics.diversity`.
+
+    .. versionadded:: 0.25.0
+    """
+    return _compute(
+        tables,
+        sample_sets,
+        windows,
+        "divergence",
+        mode,
+        True,
+        span_normalise,
+        record_neutral,
+        record_selected,
+        _all_pairs(sample_sets, indexes),
+    )
+
+
+def segregating_sites(
+    tables: TableCollection,
+    sample_sets: SampleSets,
+    *,
+    windows: Windows = None,
+    mode: str = "site",
+    span_normalise: bool = True,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+) -> np.ndarray:
+    """
+    Number of segregating sites within each sample set.
+
+    The parameters and return value are as for
+    :func:`fwdpy11.statistics.diversity`.
+
+    .. versionadded:: 0.25.0
+    """
+    return _compute(
+        tables,
+        sample_sets,
+        windows,
+        "segregating_sites",
+        mode,
+        True,
+        span_normalise,
+        record_neutral,
+        record_selected,
+        [],
+    )
+
+
+def allele_frequency_spectrum(
+    tables: TableCollection,
+    sample_sets: SampleSets,
+    *,
+    windows: Windows = None,
+    mode: str = "site",
+    polarised: bool = False,
+    span_normalise: bool = True,
+    record_neutral: bool = True,
+    record_selected: bool = True,
+) -> List[np.ndarray]:
+    """
+    Site frequency spectrum of each sample set.
+
+    :param polarised: (False) If False, return the folded spectrum
+    :type polarised: bool
+
+    :returns: One array per sample set, with one row per window
+    :rtype: list[numpy.ndarray]
+
+    For a sample set of size :math:`n`, entry :math:`i` of a row
+    is the number of variants present in :math:`i` copies.
+    The spectrum has :math:`n + 1` entries, the first and last of
+    which are always zero.  If `polarised` is False, entry :math:`i`
+    counts variants whose minor allele is present in :math:`i`
+    copies, and entries above :math:`n / 2` are zero.
+
+    In branch mode, the length of each branch is added to one
+    entry per sample set, so memory use does not grow with the
+    size of the spectrum.
+
+    The remaining parameters are as for
+    :func:`fwdpy11.statistics.diversity`.
+
+    .. versionadded:: 0.25.0
+    """
+    spectra = _compute(
+        tables,
+        sample_sets,
+        windows,
+        "allele_frequency_spectrum",
+        mode,
+        polarised,
+        span_normalise,
+        record_neutral,
+        record_selected,
+        [],
+    )
+    bounds = np.cumsum([0] + [len(s) + 1 for s in sample_sets])
+    return [spectra[..., bounds[i] : bounds[i + 1]] for i in range(len(sample_sets))]
+
+
+def tajimas_d(
+    tables: TableCollection,
+    sample_sets: SampleSets,
+    *,
+    windows: Windows = None,
+    mode: str = "site",
+    record_neutral: bool = True,
+    record_selected: bool = True,
+) -> np.ndarray:
+    """
+    Tajima's D for each sample set.
+
+    The value is ``nan`` for windows without segregating sites.
+    The parameters and return value are otherwise as for
+    :func:`fwdpy11.statistics.diversity`.
+
+    .. versionadded:: 0.25.0
+    """
+    args = (tables, sample_sets)
+    kwargs = {
+        "windows": windows,
+        "mode": mode,
+        "span_normalise": False,
+        "record_neutral": record_neutral,
+        "record_selected": record_selected,
+    }
+    pi = diversity(*args, **kwargs)
+    S = segregating_sites(*args, **kwargs)
+    n = np.array([len(s) for s in sample_sets], dtype=np.float64)
+    i = [np.arange(1, k) for k in n]
+    a1 = np.array([np.sum(1.0 / j) for j in i])
+    a2 = np.array([np.sum(1.0 / j**2) for j in i])
+    b1 = (n + 1.0) / (3.0 * (n - 1.0))
+    b2 = 2.0 * (n**2 + n + 3.0) / (9.0 * n * (n - 1.0))
+    c1 = b1 - 1.0 / a1
+    c2 = b2 - (n + 2.0) / (a1 * n) + a2 / a1**2
+    e1 = c1 / a1
+    e2 = c2 / (a1**2 + a2)
+    with np.errstate(invalid="ignore", divide="ignore"):
+        return (pi - S / a1) / np.sqrt(e1 * S + e2 * S * (S - 1.0))
+
+
+def fst(
+    tables: TableCollection,
+    sample_sets: SampleSets,
+    indexes: Indexes = None,
+    *,
+    windows: Windows = None,
+    mode: str = "site",
+    record_neutral: bool = True,
+    record_selected: bool = True,
+) -> np.ndarray:
+    """
+    Hudson's :math:`F_{ST}` between pairs of sample sets,
+    :math:`1 - \\bar{\\pi}_{within} / d_{between}`.
+
+    The parameters and return value are as for
+    :func:`fwdpy11.statistics.divergence`.
+
+    .. versionadded:: 0.25.0
+    """
+    pairs = _all_pairs(sample_sets, indexes)
+    kwargs = {
+        "windows": windows,
+        "mode": mode,
+        "span_normalise": False,
+        "record_neutral": record_neutral,
+        "record_selected": record_selected,
+    }
+    pi = diversity(tables, sample_sets, **kwargs)
+    d = divergence(tables, sample_sets, pairs, **kwargs)
+    i = [p[0] for p in pairs]
+    j = [p[1] for p in pairs]
+    with np.errstate(invalid="ignore", divide="ignore"):
+        return 1.0 - 0.5 * (pi[..., i] + pi[..., j]) / d
@@ -26,6 +26,16 @@ import numpy as np
 import tskit  # type: ignore
 
 
+def _to_tskit_ids(ids: np.ndarray) -> np.ndarray:
+    """
+    Convert row ids from our tables to the
+    32 bit integers used by tskit.
+    """
+    if len(ids) > 0 and ids.max() > np.iinfo(np.int32).max:
+        raise ValueError("table row ids are too large to export to tskit")
+    return ids.astype(np.int32, copy=False)
+
+
 def _initializePopulationTable(
     node_view, population_metadata: typing.Optional[typing.Dict[int, object]], tc
 ):
@@ -54,20 +64,24 @@ def _initializeIndividualTable(self, tc):
     # First, alive individuals:
     individal_nodes = {}
     num_ind_nodes = 0
+    alive_nodes = _to_tskit_ids(np.array(self.diploid_metadata, copy=False)["nodes"])
     for i, d in enumerate(self.diploid_metadata):
         individal_nodes[2 * i] = i
         individal_nodes[2 * i + 1] = i
         num_ind_nodes += 1
+        metadata = fwdpy11.tskit_tools.metadata_schema.generate_individual_metadata(d)
+        metadata["nodes"] = alive_nodes[i].tolist()
         tc.individuals.add_row(
             flags=fwdpy11.tskit_tools.INDIVIDUAL_IS_ALIVE,
-            metadata=fwdpy11.tskit_tools.metadata_schema.generate_individual_metadata(
-                d
-            ),
+            metadata=metadata,
         )
 
     # Now, preserved nodes
     node_time = np.array(self.tables.nodes, copy=False)["time"]
-    for i in self.ancient_sample_metadata:
+    preserved_nodes = _to_tskit_ids(
+        np.array(self.ancient_sample_metadata, copy=False)["nodes"]
+    )
+    for j, i in enumerate(self.ancient_sample_metadata):
         assert i.nodes[0] not in individal_nodes, "individual record error"
         assert i.nodes[1] not in individal_nodes, "individual record error"
         individal_nodes[i.nodes[0]] = num_ind_nodes
@@ -76,12 +90,9 @@ def _initializeIndividualTable(self, tc):
         flag = fwdpy11.tskit_tools.INDIVIDUAL_IS_PRESERVED
         if node_time[i.nodes[0]] == 0.0 and node_time[i.nodes[1]] == 0.0:
             flag |= fwdpy11.tskit_tools.INDIVIDUAL_IS_FIRST_GENERATION
-        tc.individuals.add_row(
-            flags=flag,
-            metadata=fwdpy11.tskit_tools.metadata_schema.generate_individual_metadata(
-                i
-            ),
-        )
+        metadata = fwdpy11.tskit_tools.metadata_schema.generate_individual_metadata(i)
+        metadata["nodes"] = preserved_nodes[j].tolist()
+        tc.individuals.add_row(flags=flag, metadata=metadata)
 
     return individal_nodes
 
@@ -103,7 +114,8 @@ def _dump_mutation_site_and_site_tables(
             self.mutations
         )
     )
-    for m in self.tables.mutations:
+    mutation_nodes = _to_tskit_ids(np.array(self.tables.mutations, copy=False)["node"])
+    for m, node in zip(self.tables.mutations, mutation_nodes):
         if self.mutations[m.key].g != np.iinfo(np.int32).min:
             origin_time = (
                 self.generation
@@ -111,11 +123,11 @@ def _dump_mutation_site_and_site_tables(
                 + demographic_model_time_offset
             )
         else:
-            origin_time = tc.nodes.time[m.node]
+            origin_time = tc.nodes.time[node]
 
         tc.mutations.add_row(
             site=m.site,
-            node=m.node,
+            node=node,
             derived_state="1",
             time=origin_time,
             metadata=fwdpy11.tskit_tools.metadata_schema.generate_mutation_metadata(
@@ -239,8 +251,8 @@ def _dump_tables_to_tskit(
     tc.edges.set_columns(
         left=edge_view["left"],
         right=edge_view["right"],
-        parent=edge_view["parent"],
-        child=edge_view["child"],
+        parent=_to_tskit_ids(edge_view["parent"]),
+        child=_to_tskit_ids(edge_view["child"]),
     )
     if destructive is True:
         self.tables._clear_edges()
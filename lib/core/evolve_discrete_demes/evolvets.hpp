@@ -22,6 +22,10 @@ struct evolve_with_tree_sequences_options
     bool remove_extinct_mutations_at_finish;
     bool reset_treeseqs_to_alive_nodes_after_simplification;
     bool preserve_first_generation;
+    // If true, selected fixations are removed from genomes
+    // after their effects are folded into the baseline of
+    // each genetic value object.  Overrides preserve_selected_fixations.
+    bool fold_selected_fixations;
 
     // NOTE: options below here are likely to change later,
     // as the back end becomes more general.
@@ -32,7 +36,7 @@ struct evolve_with_tree_sequences_options
           record_gvalue_matrix(false), track_mutation_counts_during_sim(false),
           remove_extinct_mutations_at_finish(true),
           reset_treeseqs_to_alive_nodes_after_simplification(false),
-          preserve_first_generation(false),
+          preserve_first_generation(false), fold_selected_fixations(false),
           allow_residual_selfing(true)
     {
     }
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/std_table_collection.hpp>
+
+namespace fwdpy11_core
+{
+    using ancestral_mutation_sums_tree_callback
+        = std::function<void(const std::vector<fwdpp::ts::table_index_t> &parents,
+                             const std::vector<std::size_t> &mutations_in_tree)>;
+
+    /* For every node u, sum values over all included mutations
+     * that are carried by u, meaning that the mutation's node is u or
+     * an ancestor of u in the tree containing the mutation's site.
+     *
+     * mutation_rows are rows of the mutation table, in any order.
+     * values has ncols entries per element of mutation_rows.
+     * On return, node_sums has ncols entries per node.
+     *
+     * The edges are visited once, from left to right, and
+     * each edge insertion or removal costs time proportional to
+     * the depth of the tree, so the total cost depends on the size
+     * of the tree sequence and not on the number of nodes times
+     * the number of sites.
+     *
+     * If callback is not empty, it is called once for each tree
+     * containing included mutations.  It receives the parent of
+     * each node in that tree and the indexes (into mutation_rows)
+     * of the included mutations in that tree.
+     *
+     * The edge table does not need to be indexed.
+     */
+    void accumulate_ancestral_mutation_sums(
+        const fwdpp::ts::std_table_collection &tables,
+        const std::vector<std::size_t> &mutation_rows, const std::vector<double> &values,
+        std::size_t ncols, std::vector<double> &node_sums,
+        const ancestral_mutation_sums_tree_callback &callback);
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/std_table_collection.hpp>
+
+namespace fwdpy11_core
+{
+    struct association_scan_result
+    // One entry per variant, in order of position.
+    {
+        std::vector<double> positions;
+        std::vector<std::size_t> keys;
+        std::vector<std::uint32_t> derived_counts;
+        std::vector<double> beta, se, pvalue;
+    };
+
+    /* Single-marker regressions of a phenotype on diploid dosage.
+     *
+     * Nodes samples[2i] and samples[2i + 1] are the two genomes of
+     * individual i, whose phenotype is phenotypes[i].  covariates
+     * is row-major, with ncovariates values per individual.
+     * Each variant is tested with the model
+     * phenotype ~ 1 + covariates + dosage, and the p-value is
+     * two-sided, from the t distribution with n - rank(1, covariates) - 1
+     * degrees of freedom.
+     *
+     * The phenotype is projected off the intercept and covariates
+     * once.  Because that residual is orthogonal to them, each variant
+     * costs O(n + carriers * rank) time: every individual's dosage is
+     * read, but only carriers of the derived allele update the
+     * projections onto the covariates.
+     *
+     * Genotypes are generated in chunks of about sites_per_chunk sites,
+     * each stored as a dense int8 matrix of sites_per_chunk rows by 2n
+     * columns, which bounds memory.  The chunks are split into
+     * num_threads blocks, each processed by its own thread.
+     */
+    association_scan_result
+    association_scan(const fwdpp::ts::std_table_collection &tables,
+                     const std::vector<fwdpp::ts::table_index_t> &samples,
+                     const std::vector<double> &phenotypes,
+                     const std::vector<double> &covariates, std::size_t ncovariates,
+                     bool record_neutral, bool record_selected,
+                     std::size_t sites_per_chunk, std::size_t num_threads);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <core/ts/packed_genotype_matrix.hpp>
+
+namespace fwdpy11_core
+{
+    struct haplotype_scan_options
+    {
+        // Integration of EHH stops once it falls to this value.
+        double min_ehh;
+        // Core sites with a minor allele frequency below
+        // this value get NaN scores.
+        double min_maf;
+        // If false, iHH is NaN when EHH does not fall to
+        // min_ehh before the first or last row.
+        bool include_edges;
+        std::size_t num_threads;
+    };
+
+    struct haplotype_scan_result
+    // One value per row of the input.
+    {
+        std::vector<double> ihh_ancestral, ihh_derived, ihs;
+        std::vector<double> sl_ancestral, sl_derived, nsl;
+    };
+
+    /* Haplotype homozygosity scores with each row of a matrix with
+     * haplotype packing as the core site.  Row positions must be sorted.
+     *
+     * For each allele at the core, the haplotypes carrying it are
+     * partitioned into groups that are identical from the core to the
+     * current row.  Moving away from the core splits each group by the
+     * state at the next row, using the bit-packed rows as masks.
+     * EHH is the fraction of pairs of haplotypes that remain
+     * in the same group.
+     *
+     * iHH integrates EHH over distance (trapezoid rule) on both sides
+     * of the core until it falls to min_ehh, and iHS is
+     * ln(iHH_ancestral / iHH_derived) (Voight et al. 2006).
+     *
+     * SL is the mean number of rows, counting the core once,
+     * over which pairs of haplotypes are identical, and nSL is
+     * ln(SL_ancestral / SL_derived) (Ferrer-Admetlla et al. 2014).
+     *
+     * The scores are not standardised.  The core sites are split
+     * into num_threads blocks, each processed by its own thread.
+     */
+    haplotype_scan_result haplotype_scan(const packed_genotype_matrix &m,
+                                         const haplotype_scan_options &options);
+
+    // EHH of each allele at the core, with the core
+    // and each other row as the end of the haplotype.
+    void ehh_decay(const packed_genotype_matrix &m, std::size_t core,
+                   std::vector<double> &ehh_ancestral,
+                   std::vector<double> &ehh_derived);
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/std_table_collection.hpp>
+
+namespace fwdpy11_core
+{
+    struct ibd_segments
+    // One entry per segment, with first < second.
+    {
+        std::vector<fwdpp::ts::table_index_t> first, second;
+        std::vector<double> left, right;
+        std::vector<fwdpp::ts::table_index_t> node;
+        std::vector<double> time;
+    };
+
+    /* Segments of the genome over which a pair of sample nodes has the
+     * same most recent common ancestor, and which are at least
+     * min_length long.  Adjacent intervals with the same MRCA are
+     * one segment.
+     *
+     * If pairs is empty, all pairs of samples are considered.
+     * Otherwise, only the given pairs are, and samples is ignored.
+     *
+     * The parents are visited from the youngest to the oldest.  Each node
+     * holds the intervals of the genome that it inherits from each
+     * sample.  A parent collects these intervals from its children
+     * through its edges, and two samples whose intervals overlap and that
+     * arrive through different children coalesce in the parent.  The
+     * intervals held by a child are released after its last edge is
+     * processed, so memory depends on the number of lineages present
+     * at one time rather than on the size of the tables.
+     */
+    ibd_segments
+    find_ibd_segments(const fwdpp::ts::std_table_collection &tables,
+                      const std::vector<fwdpp::ts::table_index_t> &samples,
+                      const std::vector<std::pair<fwdpp::ts::table_index_t,
+                                                  fwdpp::ts::table_index_t>> &pairs,
+                      double min_length);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <core/ts/packed_genotype_matrix.hpp>
+
+namespace fwdpy11_core
+{
+    struct linkage_disequilibrium_pairs
+    // One entry per pair of rows (first, second),
+    // sorted by first and then by second.
+    {
+        std::vector<std::uint32_t> first, second;
+        std::vector<double> D, r2, Dprime;
+    };
+
+    /* D, r^2 and D' for pairs of rows of a matrix
+     * with haplotype packing.
+     *
+     * The pair of rows i < j is included if j - i <= max_sites_apart
+     * and positions[j] - positions[i] <= max_distance, so that the
+     * output is a band around the diagonal of the full matrix.
+     * Row positions must be sorted.
+     *
+     * The haplotype count for a pair of sites is the popcount of the
+     * AND of their rows, so each pair costs one pass over
+     * words_per_row words.  The rows are split into num_threads
+     * contiguous blocks, each of which is processed by its own thread.
+     *
+     * r^2 and D' are NaN if either site is monomorphic in the sample.
+     * D' is signed, meaning that it is D divided by the largest value of
+     * |D| possible given the allele frequencies.
+     */
+    linkage_disequilibrium_pairs
+    linkage_disequilibrium(const packed_genotype_matrix &m, std::size_t max_sites_apart,
+                           double max_distance, std::size_t num_threads);
+}
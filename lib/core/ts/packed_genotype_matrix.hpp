@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <fwdpp/data_matrix.hpp>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/std_table_collection.hpp>
+
+namespace fwdpy11_core
+{
+    enum class genotype_packing
+    {
+        // One bit per sampled node
+        haplotype,
+        // Two bits per individual, where nodes 2i and 2i + 1
+        // of the sample form individual i
+        dosage
+    };
+
+    // Accepts "haplotype" or "dosage"
+    genotype_packing genotype_packing_from_string(const std::string &packing);
+
+    struct packed_genotype_matrix
+    /* Genotypes with one row per variable site.
+     * Entry c of a row occupies bits_per_entry() bits starting
+     * at bit c * bits_per_entry() of the row's words.
+     * Unused bits of the last word of a row are zero.
+     */
+    {
+        genotype_packing packing;
+        std::size_t ncol, words_per_row;
+        std::vector<std::uint64_t> data;
+        std::vector<double> positions;
+        std::vector<std::size_t> keys;
+
+        packed_genotype_matrix(genotype_packing packing, std::size_t nsamples);
+
+        std::size_t
+        nrow() const
+        {
+            return positions.size();
+        }
+
+        std::size_t
+        bits_per_entry() const
+        {
+            return packing == genotype_packing::haplotype ? 1 : 2;
+        }
+
+        // haplotypes holds one 0/1 state per sampled node
+        void append_row(const std::int8_t *haplotypes, double position,
+                        std::size_t key);
+
+        unsigned get(std::size_t row, std::size_t col) const;
+    };
+
+    struct packed_data_matrix
+    {
+        packed_genotype_matrix neutral, selected;
+
+        packed_data_matrix(genotype_packing packing, std::size_t nsamples)
+            : neutral(packing, nsamples), selected(packing, nsamples)
+        {
+        }
+    };
+
+    packed_data_matrix pack_data_matrix(const fwdpp::data_matrix &dm,
+                                        genotype_packing packing);
+
+    // Packs rows as they are generated, so that the unpacked
+    // matrix is never held in memory.
+    packed_data_matrix
+    packed_data_matrix_from_tables(const fwdpp::ts::std_table_collection &tables,
+                                   const std::vector<fwdpp::ts::table_index_t> &samples,
+                                   bool record_neutral, bool record_selected,
+                                   bool include_fixations, double start, double stop,
+                                   genotype_packing packing);
+
+    // The rows of a and b, in order of position.  Rows of a come
+    // first when positions are equal.  a and b must have the same
+    // packing and number of columns.
+    packed_genotype_matrix merge_by_position(const packed_genotype_matrix &a,
+                                             const packed_genotype_matrix &b);
+
+    // Number of derived alleles at each site.
+    std::vector<std::uint32_t> allele_counts(const packed_genotype_matrix &m);
+
+    // Number of heterozygous sites in each individual.
+    std::vector<std::uint32_t> heterozygous_sites(const packed_genotype_matrix &m);
+
+    // ncol x ncol matrix of the number of differences between
+    // each pair of columns.  For dosages, each site contributes
+    // the absolute difference in dosage.
+    std::vector<std::uint32_t> pairwise_differences(const packed_genotype_matrix &m);
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/std_table_collection.hpp>
+
+/* Simplify tables by splitting [0, genome_length) into
+ * num_partitions intervals containing similar numbers of edges.
+ * Each interval is simplified in its own thread and the results
+ * are then stitched back together.
+ *
+ * Requirements/guarantees:
+ *
+ * 1. The edge table must be sorted, as for any other simplification.
+ * 2. Samples are output nodes 0 through samples.size() - 1, in input order.
+ * 3. Other retained nodes are ordered by decreasing birth time
+ *    and then by input id.  Thus, the output does not depend
+ *    on the number of partitions.
+ * 4. Edges that are split at interval boundaries are merged
+ *    back together.
+ * 5. The edge table indexes are cleared.
+ *
+ * The return value is the node id map and the keys of
+ * the mutations that remain in the tables.
+ *
+ * The edges, sites and mutations are divided among the intervals
+ * in one pass, and each interval only copies the nodes that its
+ * rows refer to.  num_partitions is capped at the number of
+ * hardware threads.  With one partition, the rows are moved
+ * rather than copied and the interval is simplified in the
+ * calling thread.
+ */
+std::pair<std::vector<fwdpp::ts::table_index_t>, std::vector<std::size_t>>
+partitioned_simplification(const std::vector<fwdpp::ts::table_index_t> &samples,
+                           std::size_t num_partitions,
+                           fwdpp::ts::std_table_collection &tables);
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/std_table_collection.hpp>
+
+namespace fwdpy11_core
+{
+    enum class statistic_mode
+    {
+        // Sum over mutations in the mutation table
+        site,
+        // Sum over branches, weighted by branch length
+        branch
+    };
+
+    /* Fills output_dim values from the number of nodes in each
+     * sample set that inherit a branch or a mutation.
+     * counts has one entry per sample set.  The output is zeroed
+     * before each call.
+     */
+    using tree_statistic_summary
+        = std::function<void(const double *counts, double *output)>;
+
+    struct tree_statistic_options
+    {
+        statistic_mode mode;
+        // If false, the summary is also applied to the complement
+        // of each count, so that ancestral and derived states
+        // contribute equally.
+        bool polarised;
+        // If true, divide each window's value by the window's length
+        bool span_normalise;
+        // Site mode only: which mutations to include.
+        bool include_neutral, include_selected;
+    };
+
+    /* Windowed statistics for many sample sets in one pass
+     * over the trees.
+     *
+     * windows are breakpoints: window i is [windows[i], windows[i + 1]).
+     * The return value has output_dim values per window.
+     *
+     * As the trees are visited from left to right, inserting or
+     * removing an edge updates the per-sample-set counts of the
+     * nodes on the path from the edge to the root.  In branch mode,
+     * the summed statistic over all branches is updated along with
+     * the counts, so that each tree costs time proportional to the
+     * number of edges that changed times the depth of the tree.
+     * Branch mode stores output_dim values per node, and calls
+     * the summary once for each node on those paths, so large
+     * outputs are expensive.
+     *
+     * The summary should return zero when all counts are zero
+     * or all counts equal the sizes of the sample sets, otherwise
+     * branches ancestral to none or all of the samples contribute.
+     *
+     * The edge table indexes are used if present.
+     */
+    std::vector<double>
+    tree_statistic(const fwdpp::ts::std_table_collection &tables,
+                   const std::vector<std::vector<fwdpp::ts::table_index_t>> &sample_sets,
+                   const std::vector<double> &windows, std::size_t output_dim,
+                   const tree_statistic_summary &summary,
+                   const tree_statistic_options &options);
+
+    // The following are tree_statistic with specific summaries.
+    // For site mode, these are the usual estimators from
+    // sequence data.  For branch mode, they are their expectations
+    // given the trees, in units of generations.
+
+    // Mean pairwise differences within each sample set.
+    std::vector<double>
+    diversity(const fwdpp::ts::std_table_collection &tables,
+              const std::vector<std::vector<fwdpp::ts::table_index_t>> &sample_sets,
+              const std::vector<double> &windows, const tree_statistic_options &options);
+
+    // Mean pairwise differences between the sample sets
+    // in each pair of indexes.
+    std::vector<double>
+    divergence(const fwdpp::ts::std_table_collection &tables,
+               const std::vector<std::vector<fwdpp::ts::table_index_t>> &sample_sets,
+               const std::vector<std::pair<std::size_t, std::size_t>> &indexes,
+               const std::vector<double> &windows,
+               const tree_statistic_options &options);
+
+    // Number of segregating sites within each sample set.
+    std::vector<double>
+    segregating_sites(const fwdpp::ts::std_table_collection &tables,
+                      const std::vector<std::vector<fwdpp::ts::table_index_t>> &sample_sets,
+                      const std::vector<double> &windows,
+                      const tree_statistic_options &options);
+
+    // One site frequency spectrum per sample set, concatenated.
+    // Sample set k has sizes[k] + 1 bins.  Bins 0 and sizes[k]
+    // are always zero.  If options.polarised is false, the
+    // spectrum is folded into the first sizes[k] / 2 + 1 bins.
+    // In branch mode, branch lengths are added directly to the
+    // bins, so no per-node spectra are stored.
+    std::vector<double> allele_frequency_spectrum(
+        const fwdpp::ts::std_table_collection &tables,
+        const std::vector<std::vector<fwdpp::ts::table_index_t>> &sample_sets,
+        const std::vector<double> &windows, const tree_statistic_options &options);
+
+    /* The number of nodes from each sample set that carry
+     * each mutation, from one pass over the trees.
+     *
+     * sample_set_of_node has one entry per node, which is
+     * the index of the node's sample set or -1 if the node is
+     * in no sample set.
+     *
+     * The return value has nsets entries per mutation and
+     * is indexed by mutation key, so nmutations must be larger
+     * than the largest key in the mutation table.
+     */
+    std::vector<std::uint32_t>
+    count_mutations_by_sample_set(const fwdpp::ts::std_table_collection &tables,
+                                  const std::vector<std::int32_t> &sample_set_of_node,
+                                  std::size_t nsets, std::size_t nmutations);
+}
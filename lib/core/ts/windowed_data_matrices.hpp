@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+#include <fwdpp/data_matrix.hpp>
+#include <fwdpp/ts/definitions.hpp>
+#include <fwdpp/ts/std_table_collection.hpp>
+
+namespace fwdpy11_core
+{
+    using window_data_matrix_callback
+        = std::function<void(std::size_t window, fwdpp::data_matrix &)>;
+
+    /* Generate a fwdpp::data_matrix for each [left, right) interval.
+     *
+     * The intervals are split into num_threads contiguous blocks,
+     * each processed by a thread with its own tree visitor and
+     * matrix.  Within a block, the intervals are processed in order
+     * and overlapping intervals reuse a saved copy of the visitor.
+     *
+     * callback is called once per interval, with the index of the
+     * interval, from the thread processing it.  Calls for different
+     * intervals may be concurrent.  The callback may move data out of
+     * the matrix, which is cleared before it is reused.
+     *
+     * The interval requirements are those of DataMatrixIterator:
+     * finite, non-negative positions, right > left, and strictly
+     * increasing left positions.
+     */
+    void windowed_data_matrices(const fwdpp::ts::std_table_collection &tables,
+                                const std::vector<fwdpp::ts::table_index_t> &samples,
+                                const std::vector<std::pair<double, double>> &intervals,
+                                bool record_neutral, bool record_selected,
+                                bool include_fixations, std::size_t num_threads,
+                                const window_data_matrix_callback &callback);
+}
@@ -2,7 +2,7 @@
 
 void
 set_mutations(const std::vector<fwdpy11::Mutation> &mutations,
-              const std::vector<std::int32_t> &mutation_nodes,
+              const std::vector<fwdpp::ts::table_index_t> &mutation_nodes,
               const std::vector<fwdpy11::mutation_origin_time> &origin_times,
               fwdpy11::DiploidPopulation &pop)
 {
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <stdexcept>
 
 #include "diploid_pop_fitness.hpp"
@@ -15,15 +16,107 @@ calculate_diploid_fitness(const fwdpy11::GSLrng_t &rng, fwdpy11::DiploidPopulati
     double sum_parental_fitnesses = 0.0;
     new_diploid_gvalues.clear();
     bool all_fitneses_are_zero = true;
+
+    // Give each genetic value object the chance to
+    // process all of its individuals at once.
+    std::vector<std::vector<std::size_t>> individuals(gvalue_pointers.size());
+    std::vector<std::size_t> batch_row(offspring_metadata.size());
+    for (std::size_t i = 0; i < offspring_metadata.size(); ++i)
+        {
+            auto idx = deme_to_gvalue_map[offspring_metadata[i].deme];
+            batch_row[i] = individuals[idx].size();
+            individuals[idx].push_back(i);
+        }
+    std::vector<std::vector<double>> batch_gvalues(gvalue_pointers.size());
+    std::vector<char> batched(gvalue_pointers.size(), 0);
+    std::vector<std::size_t> focal_trait(gvalue_pointers.size(), 0);
+    // If noise and/or fitness can also be done in batch,
+    // then we do so here, once per genetic value object.
+    // Noise is only batched when there is a single genetic value
+    // object.  Otherwise, drawing it object by object would change
+    // the order of random numbers relative to drawing it
+    // individual by individual, and therefore the output of
+    // simulations with a fixed seed.
+    const bool batch_noise = gvalue_pointers.size() == 1;
+    std::vector<char> noise_batched(gvalue_pointers.size(), 0);
+    std::vector<char> fitness_batched(gvalue_pointers.size(), 0);
+    std::vector<double> g, e, w;
+    for (std::size_t idx = 0; idx < gvalue_pointers.size(); ++idx)
+        {
+            if (individuals[idx].empty())
+                {
+                    continue;
+                }
+            auto gv = gvalue_pointers[idx];
+            const auto n = individuals[idx].size();
+            batched[idx] = gv->calculate_gvalues(rng, pop, offspring_metadata,
+                                                 individuals[idx], batch_gvalues[idx]);
+            if (!batched[idx])
+                {
+                    continue;
+                }
+            if (batch_gvalues[idx].size() != n * gv->total_dim)
+                {
+                    throw std::runtime_error("batch genetic values have incorrect size");
+                }
+            focal_trait[idx] = gv->focal_trait();
+            g.resize(n);
+            e.resize(n);
+            w.resize(n);
+            for (std::size_t j = 0; j < n; ++j)
+                {
+                    g[j] = batch_gvalues[idx][j * gv->total_dim + focal_trait[idx]];
+                }
+            noise_batched[idx] = batch_noise && gv->noise_batch(rng, n, e.data());
+            if (!noise_batched[idx])
+                {
+                    continue;
+                }
+            fitness_batched[idx] = gv->genetic_value_to_fitness_batch(
+                batch_gvalues[idx].data(), g.data(), e.data(), n, w.data());
+            for (std::size_t j = 0; j < n; ++j)
+                {
+                    auto &md = offspring_metadata[individuals[idx][j]];
+                    md.g = g[j];
+                    md.e = e[j];
+                    if (fitness_batched[idx])
+                        {
+                            md.w = w[j];
+                        }
+                }
+        }
+
     for (std::size_t i = 0; i < offspring_metadata.size(); ++i)
         {
             auto idx = deme_to_gvalue_map[offspring_metadata[i].deme];
-            //gvalue_pointers[idx]->operator()(rng, offspring_metadata[i].label, pop,
-            //                                 offspring_metadata[i]);
-            gvalue_pointers[idx]->operator()(fwdpy11::DiploidGeneticValueData(
+            fwdpy11::DiploidGeneticValueData data(
                 rng, pop, pop.diploid_metadata[offspring_metadata[i].parents[0]],
                 pop.diploid_metadata[offspring_metadata[i].parents[1]], i,
-                offspring_metadata[i]));
+                offspring_metadata[i]);
+            if (batched[idx])
+                {
+                    auto &gvalues = gvalue_pointers[idx]->gvalues;
+                    auto row = begin(batch_gvalues[idx])
+                               + batch_row[i] * gvalue_pointers[idx]->total_dim;
+                    std::copy(row, row + gvalue_pointers[idx]->total_dim,
+                              begin(gvalues));
+                    offspring_metadata[i].g = gvalues[focal_trait[idx]];
+                    if (!noise_batched[idx])
+                        {
+                            gvalue_pointers[idx]->apply_noise_and_fitness(data);
+                        }
+                    else if (!fitness_batched[idx])
+                        {
+                            offspring_metadata[i].w
+                                = gvalue_pointers[idx]->genetic_value_to_fitness(
+                                    fwdpy11::DiploidGeneticValueToFitnessData(data,
+                                                                              gvalues));
+                        }
+                }
+            else
+                {
+                    gvalue_pointers[idx]->operator()(data);
+                }
             if (update_genotype_matrix == true)
                 {
                     new_diploid_gvalues.insert(end(new_diploid_gvalues),
@@ -40,6 +40,7 @@
 #include <fwdpy11/types/Diploid.hpp>
 #include <core/gsl/gsl_discrete.hpp>
 #include "discrete_demography/discrete_demography.hpp"
+#include "squash_breakpoints.hpp"
 
 template <typename poptype, typename rng_t, typename genetic_param_holder>
 std::pair<fwdpp::ts::mut_rec_intermediates, fwdpp::ts::mut_rec_intermediates>
@@ -255,6 +256,11 @@ evolve_generation_ts(
                             auto p2id = parent_nodes_from_metadata(
                                 pdata.parent2, pop.diploid_metadata,
                                 offspring_data.second.swapped);
+                            // The offspring genomes are already made,
+                            // so we can drop redundant breakpoints before
+                            // adding edges to the buffer.
+                            squash_breakpoints(offspring_data.first.breakpoints, p1id);
+                            squash_breakpoints(offspring_data.second.breakpoints, p2id);
                             fwdpp::ts::table_index_t offspring_node_1
                                 = fwdpp::ts::record_diploid_offspring(
                                     offspring_data.first.breakpoints, p1id,
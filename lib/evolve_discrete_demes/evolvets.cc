@@ -24,6 +24,7 @@
 #include "runtime_checks.hpp"
 #include "evolve_generation_ts.hpp"
 #include "simplify_tables.hpp"
+#include "fold_selected_fixations.hpp"
 #include "discrete_demography/simulation/multideme_fitness_bookmark.hpp"
 
 #include <core/evolve_discrete_demes/evolvets.hpp>
@@ -41,6 +42,7 @@ apply_treseq_resetting_of_ancient_samples(
         {
             pop.ancient_sample_metadata.clear();
             pop.ancient_sample_genetic_value_matrix.clear();
+            pop.reset_preserved_node_index();
         }
 }
 
@@ -87,10 +89,12 @@ simplification(
 void
 final_population_cleanup(
     bool suppress_edge_table_indexing, bool preserve_selected_fixations,
-    bool remove_extinct_mutations_at_finish, bool simulating_neutral_variants,
+    bool fold_fixations, bool remove_extinct_mutations_at_finish,
+    bool simulating_neutral_variants,
     bool reset_treeseqs_to_alive_nodes_after_simplification,
     std::uint32_t last_preserved_generation,
     const std::vector<std::uint32_t> & /*last_preserved_generation_counts*/,
+    const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values,
     fwdpy11::DiploidPopulation &pop)
 {
     index_and_count_mutations(suppress_edge_table_indexing, simulating_neutral_variants,
@@ -124,6 +128,10 @@ final_population_cleanup(
                 {
                     fwdpp::ts::rebuild_site_table(*pop.tables);
                 }
+            if (fold_fixations)
+                {
+                    fold_selected_fixations(genetic_values, pop);
+                }
             fwdpp::ts::remove_fixations_from_haploid_genomes(
                 pop.haploid_genomes, pop.mutations, pop.mcounts,
                 pop.mcounts_from_preserved_nodes, 2 * pop.diploids.size(),
@@ -215,6 +223,12 @@ evolve_with_tree_sequences(
         {
             throw std::invalid_argument("empty list of genetic values");
         }
+    if (options.fold_selected_fixations)
+        {
+            validate_fold_selected_fixations(gvalue_pointers.genetic_values);
+            options.preserve_selected_fixations = false;
+        }
+    prepare_fixation_baselines(gvalue_pointers.genetic_values, pop);
     //validate the input params
     if (pop.tables->genome_length() == std::numeric_limits<double>::max())
         {
@@ -440,6 +454,9 @@ evolve_with_tree_sequences(
                                    last_preserved_generation_counts, pop);
         }
 
+    // The preserved node index is built incrementally
+    // while simulating, starting from the current metadata.
+    pop.reset_preserved_node_index();
     std::vector<fwdpp::ts::table_index_t> alive_at_last_simplification(pop.alive_nodes);
     new_edge_buffer->reset(alive_at_last_simplification.size());
 
@@ -537,6 +554,11 @@ evolve_with_tree_sequences(
                             if (options.preserve_selected_fixations == false)
                                 {
                                     // b/c neutral mutations not in genomes!
+                                    if (options.fold_selected_fixations)
+                                        {
+                                            fold_selected_fixations(
+                                                gvalue_pointers.genetic_values, pop);
+                                        }
                                     fwdpp::ts::remove_fixations_from_haploid_genomes(
                                         pop.haploid_genomes, pop.mutations, pop.mcounts,
                                         pop.mcounts_from_preserved_nodes,
@@ -618,6 +640,11 @@ evolve_with_tree_sequences(
                                         {
                                             fwdpp::ts::rebuild_site_table(*pop.tables);
                                         }
+                                    if (options.fold_selected_fixations)
+                                        {
+                                            fold_selected_fixations(
+                                                gvalue_pointers.genetic_values, pop);
+                                        }
                                     fwdpp::ts::remove_fixations_from_haploid_genomes(
                                         pop.haploid_genomes, pop.mutations, pop.mcounts,
                                         pop.mcounts_from_preserved_nodes,
@@ -677,7 +704,6 @@ evolve_with_tree_sequences(
         });
     pop.preserved_sample_nodes.erase(itr, end(pop.preserved_sample_nodes));
     pop.alive_nodes.clear();
-    pop.preserved_sample_nodes.clear();
     pop.ancient_sample_metadata.erase(
         std::remove_if(begin(pop.ancient_sample_metadata),
                        end(pop.ancient_sample_metadata),
@@ -685,6 +711,7 @@ evolve_with_tree_sequences(
                            return pop.tables->nodes[md.nodes[0]].time == pop.generation;
                        }),
         end(pop.ancient_sample_metadata));
+    pop.reset_preserved_node_index();
 
     if (!simplified)
         {
@@ -696,6 +723,10 @@ evolve_with_tree_sequences(
                            alive_at_last_simplification, pop);
             if (!options.preserve_selected_fixations)
                 {
+                    if (options.fold_selected_fixations)
+                        {
+                            fold_selected_fixations(gvalue_pointers.genetic_values, pop);
+                        }
                     fwdpp::ts::remove_fixations_from_haploid_genomes(
                         pop.haploid_genomes, pop.mutations, pop.mcounts,
                         pop.mcounts_from_preserved_nodes, 2 * pop.diploids.size(),
@@ -706,9 +737,11 @@ evolve_with_tree_sequences(
     new_edge_buffer.reset(nullptr);
     final_population_cleanup(
         options.suppress_edge_table_indexing, options.preserve_selected_fixations,
-        options.remove_extinct_mutations_at_finish, simulating_neutral_variants,
+        options.fold_selected_fixations, options.remove_extinct_mutations_at_finish,
+        simulating_neutral_variants,
         options.reset_treeseqs_to_alive_nodes_after_simplification,
-        last_preserved_generation, last_preserved_generation_counts, pop);
+        last_preserved_generation, last_preserved_generation_counts,
+        gvalue_pointers.genetic_values, pop);
     if (pop.tables->edges.size() != pop.tables->input_left.size()
         || pop.tables->edges.size() != pop.tables->output_right.size())
         {
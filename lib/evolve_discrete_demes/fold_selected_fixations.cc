@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <stdexcept>
+#include "fold_selected_fixations.hpp"
+
+namespace
+{
+    std::vector<fwdpy11::DiploidGeneticValue *>
+    unique_genetic_values(
+        const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values)
+    // The same object may be used for more than one deme,
+    // but each fixation must only be folded into it once.
+    {
+        auto rv(genetic_values);
+        std::sort(begin(rv), end(rv));
+        rv.erase(std::unique(begin(rv), end(rv)), end(rv));
+        return rv;
+    }
+}
+
+void
+validate_fold_selected_fixations(
+    const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values)
+{
+    for (auto gv : genetic_values)
+        {
+            if (!gv->can_fold_fixations())
+                {
+                    throw std::invalid_argument(
+                        "genetic value type cannot fold selected fixations");
+                }
+        }
+}
+
+void
+prepare_fixation_baselines(
+    const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values,
+    const fwdpy11::DiploidPopulation &pop)
+// The baseline belongs to the population being simulated,
+// but is stored in the genetic value objects, which may be
+// reused for another population.  A population with no folded
+// fixations starts from the initial baseline.  Otherwise, each
+// object must have folded the same number of fixations as the
+// population.
+{
+    for (auto gv : unique_genetic_values(genetic_values))
+        {
+            if (pop.num_folded_fixations == 0)
+                {
+                    gv->reset_fixation_baseline();
+                    gv->num_folded_fixations = 0;
+                }
+            else if (!gv->can_fold_fixations()
+                     || gv->num_folded_fixations != pop.num_folded_fixations)
+                {
+                    throw std::invalid_argument(
+                        "the population has folded selected fixations that are "
+                        "not in the fixation baseline of the genetic value object");
+                }
+        }
+}
+
+void
+fold_selected_fixations(const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values,
+                        fwdpy11::DiploidPopulation &pop)
+// Must be called immediately before
+// fwdpp::ts::remove_fixations_from_haploid_genomes,
+// using the same mutation counts.  Any mutation that
+// is fixed in the genomes is present in every genome,
+// so the first genome of the first diploid gives the
+// candidates.  Mutations already removed from the genomes
+// are not present there, so nothing is folded twice.
+{
+    if (pop.diploids.empty())
+        {
+            return;
+        }
+    const auto twoN = 2 * pop.diploids.size();
+    const auto gvalues = unique_genetic_values(genetic_values);
+    for (auto key : pop.haploid_genomes[pop.diploids[0].first].smutations)
+        {
+            if (key < pop.mcounts.size() && pop.mcounts[key] == twoN
+                && pop.mcounts_from_preserved_nodes[key] == 0)
+                {
+                    for (auto gv : gvalues)
+                        {
+                            gv->fold_fixation(pop.mutations[key]);
+                            ++gv->num_folded_fixations;
+                        }
+                    ++pop.num_folded_fixations;
+                }
+        }
+}
@@ -0,0 +1,19 @@
+#ifndef FWDPY11_TSEVOLUTION_FOLD_SELECTED_FIXATIONS_HPP
+#define FWDPY11_TSEVOLUTION_FOLD_SELECTED_FIXATIONS_HPP
+
+#include <vector>
+#include <fwdpy11/types/DiploidPopulation.hpp>
+#include <fwdpy11/genetic_values/DiploidGeneticValue.hpp>
+
+void validate_fold_selected_fixations(
+    const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values);
+
+void prepare_fixation_baselines(
+    const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values,
+    const fwdpy11::DiploidPopulation &pop);
+
+void
+fold_selected_fixations(const std::vector<fwdpy11::DiploidGeneticValue *> &genetic_values,
+                        fwdpy11::DiploidPopulation &pop);
+
+#endif
@@ -57,10 +57,7 @@ simplify_tables(poptype &pop, std::vector<fwdpp::uint_t> &mcounts_from_preserved
         {
             s = simplification_output.idmap[s];
         }
-    for (auto &s : pop.preserved_sample_nodes)
-        {
-            s = simplification_output.idmap[s];
-        }
+    pop.remap_preserved_nodes(simplification_output.idmap);
     // Remove mutations that are simplified out
     // from the population hash table.
     std::vector<int> preserved(pop.mutations.size(), 0);
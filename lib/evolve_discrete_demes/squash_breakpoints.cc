@@ -0,0 +1,36 @@
+#include <limits>
+#include <utility>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+
+void
+squash_breakpoints(
+    std::vector<double>& breakpoints,
+    std::pair<fwdpp::ts::table_index_t, fwdpp::ts::table_index_t>& parental_nodes)
+{
+    if (breakpoints.size() < 2)
+        {
+            return;
+        }
+    // Treat the vector as a stack so that runs
+    // of identical breakpoints cancel in pairs.
+    std::size_t n = 0;
+    for (std::size_t i = 0; i < breakpoints.size(); ++i)
+        {
+            if (n > 0 && breakpoints[i] == breakpoints[n - 1]
+                && breakpoints[i] != std::numeric_limits<double>::max())
+                {
+                    --n;
+                }
+            else
+                {
+                    breakpoints[n++] = breakpoints[i];
+                }
+        }
+    breakpoints.resize(n);
+    if (breakpoints.front() == 0.0)
+        {
+            breakpoints.erase(begin(breakpoints));
+            std::swap(parental_nodes.first, parental_nodes.second);
+        }
+}
@@ -0,0 +1,25 @@
+#ifndef FWDPY11_EVOLVE_SQUASH_BREAKPOINTS_HPP
+#define FWDPY11_EVOLVE_SQUASH_BREAKPOINTS_HPP
+
+#include <utility>
+#include <vector>
+#include <fwdpp/ts/definitions.hpp>
+
+// Remove crossovers that do not change which parental
+// node a segment is inherited from.  Without this step,
+// fwdpp::ts::record_diploid_offspring would buffer zero-length
+// edges followed by adjacent edges with the same parent and
+// child, which simplification later has to merge.
+//
+// * Pairs of breakpoints at the same position cancel.
+// * A breakpoint at position 0 is removed by swapping
+//   the parental nodes.
+//
+// The input must be sorted and end with
+// std::numeric_limits<double>::max(), as returned by
+// the recombination models.
+void squash_breakpoints(
+    std::vector<double>& breakpoints,
+    std::pair<fwdpp::ts::table_index_t, fwdpp::ts::table_index_t>& parental_nodes);
+
+#endif
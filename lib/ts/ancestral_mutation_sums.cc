@@ -0,0 +1,189 @@
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <core/ts/ancestral_mutation_sums.hpp>
+
+namespace
+{
+    // Let x[u] be the values stored for node u.  The sum for any
+    // node is the sum of x over the node and its ancestors in the
+    // current tree.  Adding a mutation on node u increments x[u].
+    // Removing the edge above c would drop the sums of c's ancestors
+    // from every node below c, so they are added to x[c].
+    // Inserting an edge above c subtracts the sums of its new ancestors.
+    // Once all edges have been removed, x holds the final sums.
+    class lazy_path_sums
+    {
+      private:
+        const std::size_t ncols;
+        std::vector<fwdpp::ts::table_index_t> &parents;
+        std::vector<double> &x;
+        std::vector<double> path;
+
+        void
+        sum_path(fwdpp::ts::table_index_t u)
+        {
+            std::fill(begin(path), end(path), 0.0);
+            while (u != fwdpp::ts::NULL_INDEX)
+                {
+                    const double *xu = x.data() + u * ncols;
+                    for (std::size_t c = 0; c < ncols; ++c)
+                        {
+                            path[c] += xu[c];
+                        }
+                    u = parents[u];
+                }
+        }
+
+      public:
+        lazy_path_sums(std::size_t ncols_, std::vector<fwdpp::ts::table_index_t> &p,
+                       std::vector<double> &x_)
+            : ncols(ncols_), parents(p), x(x_), path(ncols_, 0.0)
+        {
+        }
+
+        void
+        remove_edge(const fwdpp::ts::edge &e)
+        {
+            sum_path(e.parent);
+            double *xc = x.data() + e.child * ncols;
+            for (std::size_t c = 0; c < ncols; ++c)
+                {
+                    xc[c] += path[c];
+                }
+            parents[e.child] = fwdpp::ts::NULL_INDEX;
+        }
+
+        void
+        insert_edge(const fwdpp::ts::edge &e)
+        {
+            sum_path(e.parent);
+            double *xc = x.data() + e.child * ncols;
+            for (std::size_t c = 0; c < ncols; ++c)
+                {
+                    xc[c] -= path[c];
+                }
+            parents[e.child] = e.parent;
+        }
+
+        void
+        add_mutation(fwdpp::ts::table_index_t u, const double *values)
+        {
+            double *xu = x.data() + u * ncols;
+            for (std::size_t c = 0; c < ncols; ++c)
+                {
+                    xu[c] += values[c];
+                }
+        }
+    };
+}
+
+namespace fwdpy11_core
+{
+    void
+    accumulate_ancestral_mutation_sums(const fwdpp::ts::std_table_collection &tables,
+                                       const std::vector<std::size_t> &mutation_rows,
+                                       const std::vector<double> &values,
+                                       std::size_t ncols, std::vector<double> &node_sums,
+                                       const ancestral_mutation_sums_tree_callback &callback)
+    {
+        if (ncols == 0)
+            {
+                throw std::invalid_argument("number of columns must be > 0");
+            }
+        if (values.size() != mutation_rows.size() * ncols)
+            {
+                throw std::invalid_argument(
+                    "number of values does not match number of mutations");
+            }
+        const auto &edges = tables.edges;
+        const auto nnodes = tables.nodes.size();
+        for (const auto &e : edges)
+            {
+                if (e.parent < 0 || static_cast<std::size_t>(e.parent) >= nnodes
+                    || e.child < 0 || static_cast<std::size_t>(e.child) >= nnodes)
+                    {
+                        throw std::invalid_argument("edge refers to an invalid node");
+                    }
+            }
+        const auto position = [&tables, &mutation_rows](std::size_t i) {
+            return tables.sites[tables.mutations[mutation_rows[i]].site].position;
+        };
+        for (auto row : mutation_rows)
+            {
+                if (row >= tables.mutations.size())
+                    {
+                        throw std::invalid_argument("mutation row is out of range");
+                    }
+                const auto &mr = tables.mutations[row];
+                if (static_cast<std::size_t>(mr.site) >= tables.sites.size()
+                    || mr.node < 0 || static_cast<std::size_t>(mr.node) >= nnodes)
+                    {
+                        throw std::invalid_argument("invalid mutation record");
+                    }
+            }
+
+        std::vector<std::size_t> insertion(edges.size()), removal(edges.size()),
+            order(mutation_rows.size());
+        std::iota(begin(insertion), end(insertion), 0);
+        std::iota(begin(removal), end(removal), 0);
+        std::iota(begin(order), end(order), 0);
+        std::stable_sort(begin(insertion), end(insertion),
+                         [&edges](std::size_t a, std::size_t b) {
+                             return edges[a].left < edges[b].left;
+                         });
+        std::stable_sort(begin(removal), end(removal),
+                         [&edges](std::size_t a, std::size_t b) {
+                             return edges[a].right < edges[b].right;
+                         });
+        std::stable_sort(begin(order), end(order),
+                         [&position](std::size_t a, std::size_t b) {
+                             return position(a) < position(b);
+                         });
+
+        std::vector<fwdpp::ts::table_index_t> parents(nnodes, fwdpp::ts::NULL_INDEX);
+        node_sums.assign(nnodes * ncols, 0.0);
+        lazy_path_sums sums(ncols, parents, node_sums);
+        std::vector<std::size_t> mutations_in_tree;
+        const double genome_length = tables.genome_length();
+        std::size_t j = 0, k = 0, m = 0;
+        double left = 0.0;
+        while (left < genome_length)
+            {
+                while (k < removal.size() && edges[removal[k]].right == left)
+                    {
+                        sums.remove_edge(edges[removal[k++]]);
+                    }
+                while (j < insertion.size() && edges[insertion[j]].left == left)
+                    {
+                        sums.insert_edge(edges[insertion[j++]]);
+                    }
+                double right = genome_length;
+                if (j < insertion.size())
+                    {
+                        right = std::min(right, edges[insertion[j]].left);
+                    }
+                if (k < removal.size())
+                    {
+                        right = std::min(right, edges[removal[k]].right);
+                    }
+                mutations_in_tree.clear();
+                for (; m < order.size() && position(order[m]) < right; ++m)
+                    {
+                        const auto i = order[m];
+                        sums.add_mutation(tables.mutations[mutation_rows[i]].node,
+                                          values.data() + i * ncols);
+                        mutations_in_tree.push_back(i);
+                    }
+                if (callback && !mutations_in_tree.empty())
+                    {
+                        callback(parents, mutations_in_tree);
+                    }
+                left = right;
+            }
+        for (; k < removal.size(); ++k)
+            {
+                sums.remove_edge(edges[removal[k]]);
+            }
+    }
+}
@@ -0,0 +1,298 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <gsl/gsl_cdf.h>
+#include <core/ts/association_scan.hpp>
+#include <core/ts/windowed_data_matrices.hpp>
+
+namespace
+{
+    using fwdpy11_core::association_scan_result;
+
+    // Below this, a column is treated as linearly
+    // dependent on the preceding columns.
+    constexpr double RELATIVE_TOLERANCE = 1e-10;
+
+    class linear_model
+    // The intercept and covariates, as orthonormal columns, and
+    // the phenotype with their contribution removed.
+    {
+      private:
+        std::size_t n;
+        // Row-major, n x rank
+        std::vector<double> basis;
+
+        double
+        dot(const std::vector<double> &a, const std::vector<double> &b) const
+        {
+            double rv = 0.0;
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    rv += a[i] * b[i];
+                }
+            return rv;
+        }
+
+        void
+        project_out(std::vector<double> &x) const
+        {
+            for (std::size_t k = 0; k < rank; ++k)
+                {
+                    double proj = 0.0;
+                    for (std::size_t i = 0; i < n; ++i)
+                        {
+                            proj += basis[i * rank + k] * x[i];
+                        }
+                    for (std::size_t i = 0; i < n; ++i)
+                        {
+                            x[i] -= proj * basis[i * rank + k];
+                        }
+                }
+        }
+
+      public:
+        std::size_t rank;
+        std::vector<double> residual;
+        double residual_ss;
+
+        linear_model(const std::vector<double> &phenotypes,
+                     const std::vector<double> &covariates, std::size_t ncovariates)
+            : n(phenotypes.size()), basis{}, rank(0), residual(phenotypes),
+              residual_ss(0.0)
+        {
+            std::vector<std::vector<double>> columns;
+            for (std::size_t c = 0; c <= ncovariates; ++c)
+                {
+                    std::vector<double> x(n, 1.0);
+                    if (c > 0)
+                        {
+                            for (std::size_t i = 0; i < n; ++i)
+                                {
+                                    x[i] = covariates[i * ncovariates + c - 1];
+                                }
+                        }
+                    const double norm = std::sqrt(dot(x, x));
+                    // Modified Gram-Schmidt against the accepted columns
+                    for (auto &q : columns)
+                        {
+                            const double p = dot(q, x);
+                            for (std::size_t i = 0; i < n; ++i)
+                                {
+                                    x[i] -= p * q[i];
+                                }
+                        }
+                    const double rnorm = std::sqrt(dot(x, x));
+                    if (!(rnorm > RELATIVE_TOLERANCE * norm))
+                        {
+                            continue;
+                        }
+                    for (auto &xi : x)
+                        {
+                            xi /= rnorm;
+                        }
+                    columns.push_back(std::move(x));
+                }
+            rank = columns.size();
+            basis.resize(n * rank);
+            for (std::size_t k = 0; k < rank; ++k)
+                {
+                    for (std::size_t i = 0; i < n; ++i)
+                        {
+                            basis[i * rank + k] = columns[k][i];
+                        }
+                }
+            project_out(residual);
+            residual_ss = dot(residual, residual);
+        }
+
+        const double *
+        basis_row(std::size_t i) const
+        {
+            return basis.data() + i * rank;
+        }
+    };
+
+    struct dosage_test
+    {
+        const linear_model &model;
+        const double df;
+        std::vector<double> projection;
+
+        dosage_test(const linear_model &m, std::size_t n)
+            : model(m), df(static_cast<double>(n) - static_cast<double>(m.rank) - 1.0),
+              projection(m.rank)
+        {
+        }
+
+        void
+        operator()(const std::int8_t *genotypes, std::size_t n, double position,
+                   std::size_t key, association_scan_result &rv)
+        // genotypes holds 2n haplotypes.  Only carriers of the
+        // derived allele contribute to the sums.
+        {
+            std::fill(begin(projection), end(projection), 0.0);
+            double xx = 0.0, xy = 0.0;
+            std::uint32_t count = 0;
+            for (std::size_t i = 0; i < n; ++i)
+                {
+                    const int x = (genotypes[2 * i] != 0) + (genotypes[2 * i + 1] != 0);
+                    if (x == 0)
+                        {
+                            continue;
+                        }
+                    count += static_cast<std::uint32_t>(x);
+                    xx += x * x;
+                    xy += x * model.residual[i];
+                    const double *q = model.basis_row(i);
+                    for (std::size_t k = 0; k < model.rank; ++k)
+                        {
+                            projection[k] += x * q[k];
+                        }
+                }
+            double sxx = xx;
+            for (auto p : projection)
+                {
+                    sxx -= p * p;
+                }
+            double beta = std::numeric_limits<double>::quiet_NaN();
+            double se = beta, pvalue = beta;
+            if (sxx > RELATIVE_TOLERANCE * xx)
+                {
+                    beta = xy / sxx;
+                    const double rss = std::max(model.residual_ss - beta * xy, 0.0);
+                    se = std::sqrt(rss / df / sxx);
+                    pvalue = se > 0.0 ? 2.0 * gsl_cdf_tdist_Q(std::fabs(beta / se), df)
+                                      : 0.0;
+                }
+            rv.positions.push_back(position);
+            rv.keys.push_back(key);
+            rv.derived_counts.push_back(count);
+            rv.beta.push_back(beta);
+            rv.se.push_back(se);
+            rv.pvalue.push_back(pvalue);
+        }
+    };
+
+    std::vector<std::pair<double, double>>
+    chunk_intervals(const fwdpp::ts::std_table_collection &tables,
+                    std::size_t sites_per_chunk)
+    {
+        std::vector<std::pair<double, double>> rv;
+        const auto &sites = tables.sites;
+        for (std::size_t i = 0; i < sites.size(); i += sites_per_chunk)
+            {
+                const double right = i + sites_per_chunk < sites.size()
+                                         ? sites[i + sites_per_chunk].position
+                                         : tables.genome_length();
+                rv.emplace_back(i == 0 ? 0.0 : sites[i].position, right);
+            }
+        return rv;
+    }
+
+    void
+    append(association_scan_result &to, association_scan_result &from)
+    {
+        to.positions.insert(end(to.positions), begin(from.positions),
+                            end(from.positions));
+        to.keys.insert(end(to.keys), begin(from.keys), end(from.keys));
+        to.derived_counts.insert(end(to.derived_counts), begin(from.derived_counts),
+                                 end(from.derived_counts));
+        to.beta.insert(end(to.beta), begin(from.beta), end(from.beta));
+        to.se.insert(end(to.se), begin(from.se), end(from.se));
+        to.pvalue.insert(end(to.pvalue), begin(from.pvalue), end(from.pvalue));
+        from = association_scan_result{};
+    }
+}
+
+namespace fwdpy11_core
+{
+    association_scan_result
+    association_scan(const fwdpp::ts::std_table_collection &tables,
+                     const std::vector<fwdpp::ts::table_index_t> &samples,
+                     const std::vector<double> &phenotypes,
+                     const std::vector<double> &covariates, std::size_t ncovariates,
+                     bool record_neutral, bool record_selected,
+                     std::size_t sites_per_chunk, std::size_t num_threads)
+    {
+        if (samples.empty() || samples.size() % 2 != 0)
+            {
+                throw std::invalid_argument(
+                    "samples must contain two nodes per individual");
+            }
+        const auto n = samples.size() / 2;
+        if (phenotypes.size() != n)
+            {
+                throw std::invalid_argument(
+                    "there must be one phenotype per individual");
+            }
+        if (covariates.size() != n * ncovariates)
+            {
+                throw std::invalid_argument(
+                    "there must be ncovariates covariates per individual");
+            }
+        for (auto x : phenotypes)
+            {
+                if (!std::isfinite(x))
+                    {
+                        throw std::invalid_argument("phenotypes must be finite");
+                    }
+            }
+        for (auto x : covariates)
+            {
+                if (!std::isfinite(x))
+                    {
+                        throw std::invalid_argument("covariates must be finite");
+                    }
+            }
+        if (sites_per_chunk == 0)
+            {
+                throw std::invalid_argument("sites_per_chunk must be > 0");
+            }
+        const linear_model model(phenotypes, covariates, ncovariates);
+        if (static_cast<double>(n) - static_cast<double>(model.rank) - 1.0 < 1.0)
+            {
+                throw std::invalid_argument(
+                    "too few individuals for the number of covariates");
+            }
+        const auto intervals = chunk_intervals(tables, sites_per_chunk);
+        if (intervals.empty())
+            {
+                return association_scan_result{};
+            }
+        std::vector<association_scan_result> chunks(intervals.size());
+        windowed_data_matrices(
+            tables, samples, intervals, record_neutral, record_selected, false,
+            num_threads, [&chunks, &model, n](std::size_t chunk, fwdpp::data_matrix &dm) {
+                // Each chunk has its own slot, so no locking is needed.
+                dosage_test test(model, n);
+                auto &out = chunks[chunk];
+                const auto &neutral = dm.neutral, &selected = dm.selected;
+                const auto nsamples = 2 * n;
+                std::size_t i = 0, j = 0;
+                while (i < dm.neutral_keys.size() || j < dm.selected_keys.size())
+                    {
+                        if (j == dm.selected_keys.size()
+                            || (i < dm.neutral_keys.size()
+                                && neutral.positions[i] <= selected.positions[j]))
+                            {
+                                test(neutral.data.data() + i * nsamples, n,
+                                     neutral.positions[i], dm.neutral_keys[i], out);
+                                ++i;
+                            }
+                        else
+                            {
+                                test(selected.data.data() + j * nsamples, n,
+                                     selected.positions[j], dm.selected_keys[j], out);
+                                ++j;
+                            }
+                    }
+            });
+        association_scan_result rv;
+        for (auto &c : chunks)
+            {
+                append(rv, c);
+            }
+        return rv;
+    }
+}
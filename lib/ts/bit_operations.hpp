@@ -0,0 +1,44 @@
+#ifndef FWDPY11_TS_BIT_OPERATIONS_HPP
+#define FWDPY11_TS_BIT_OPERATIONS_HPP
+
+#include <cstdint>
+
+namespace fwdpy11_core
+{
+    namespace internal
+    {
+        // Selects the low bit of each 2-bit entry
+        constexpr std::uint64_t LOW_BITS = 0x5555555555555555ULL;
+
+        inline unsigned
+        popcount(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_popcountll(x));
+#else
+            x = x - ((x >> 1) & LOW_BITS);
+            x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+            x = (x + (x >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+            return static_cast<unsigned>((x * 0x0101010101010101ULL) >> 56);
+#endif
+        }
+
+        inline unsigned
+        lowest_set_bit(std::uint64_t x)
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+            unsigned rv = 0;
+            while ((x & 1) == 0)
+                {
+                    x >>= 1;
+                    ++rv;
+                }
+            return rv;
+#endif
+        }
+    }
+}
+
+#endif
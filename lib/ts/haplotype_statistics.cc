@@ -0,0 +1,273 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <core/ts/haplotype_statistics.hpp>
+#include "bit_operations.hpp"
+#include "parallel_blocks.hpp"
+
+namespace
+{
+    constexpr double NaN = std::numeric_limits<double>::quiet_NaN();
+
+    class haplotype_groups
+    // Partition of the haplotypes that carry one allele at the
+    // core site into groups that are identical at all rows visited
+    // so far.  Each group is a bit mask over the columns.
+    // Groups of one haplotype cannot contribute to EHH,
+    // so they are dropped.
+    {
+      private:
+        std::size_t words;
+        std::vector<std::uint64_t> groups, next, part;
+        double pairs_at_core, pairs;
+
+        static double
+        npairs(double n)
+        {
+            return n * (n - 1.0) / 2.0;
+        }
+
+        double
+        add_group(std::vector<std::uint64_t> &dest, const std::uint64_t *g)
+        // Returns the number of pairs in g.
+        {
+            unsigned n = 0;
+            for (std::size_t w = 0; w < words; ++w)
+                {
+                    n += fwdpy11_core::internal::popcount(g[w]);
+                }
+            if (n < 2)
+                {
+                    return 0.0;
+                }
+            dest.insert(end(dest), g, g + words);
+            return npairs(n);
+        }
+
+      public:
+        explicit haplotype_groups(std::size_t words_per_row)
+            : words(words_per_row), groups{}, next{}, part(words_per_row),
+              pairs_at_core(0.0), pairs(0.0)
+        {
+        }
+
+        void
+        reset(const std::vector<std::uint64_t> &mask)
+        {
+            groups.clear();
+            pairs_at_core = pairs = add_group(groups, mask.data());
+        }
+
+        bool
+        empty() const
+        {
+            return groups.empty();
+        }
+
+        double
+        ehh() const
+        {
+            return pairs_at_core > 0.0 ? pairs / pairs_at_core : 0.0;
+        }
+
+        void
+        split(const std::uint64_t *row)
+        {
+            next.clear();
+            pairs = 0.0;
+            for (std::size_t g = 0; g < groups.size(); g += words)
+                {
+                    const auto *group = groups.data() + g;
+                    for (std::size_t w = 0; w < words; ++w)
+                        {
+                            part[w] = group[w] & row[w];
+                        }
+                    pairs += add_group(next, part.data());
+                    for (std::size_t w = 0; w < words; ++w)
+                        {
+                            part[w] = group[w] & ~row[w];
+                        }
+                    pairs += add_group(next, part.data());
+                }
+            groups.swap(next);
+        }
+    };
+
+    struct one_side
+    {
+        double ihh, sl;
+        bool reached_min_ehh;
+    };
+
+    one_side
+    walk(const fwdpy11_core::packed_genotype_matrix &m, std::size_t core, int direction,
+         double min_ehh, haplotype_groups &groups)
+    // Integrates EHH moving away from the core in one direction.
+    // groups must hold the partition at the core.
+    {
+        one_side rv{0.0, 0.0, false};
+        double previous_ehh = 1.0, previous_position = m.positions[core];
+        auto row = static_cast<std::ptrdiff_t>(core) + direction;
+        const auto nrow = static_cast<std::ptrdiff_t>(m.nrow());
+        for (; row >= 0 && row < nrow && !groups.empty(); row += direction)
+            {
+                groups.split(m.data.data() + row * m.words_per_row);
+                const double e = groups.ehh();
+                rv.sl += e;
+                if (!rv.reached_min_ehh)
+                    {
+                        rv.ihh += 0.5 * (e + previous_ehh)
+                                  * std::fabs(m.positions[row] - previous_position);
+                        rv.reached_min_ehh = e <= min_ehh;
+                    }
+                previous_ehh = e;
+                previous_position = m.positions[row];
+            }
+        return rv;
+    }
+
+    void
+    allele_masks(const fwdpy11_core::packed_genotype_matrix &m, std::size_t core,
+                 std::vector<std::uint64_t> &ancestral,
+                 std::vector<std::uint64_t> &derived)
+    {
+        const auto *row = m.data.data() + core * m.words_per_row;
+        derived.assign(row, row + m.words_per_row);
+        ancestral.resize(m.words_per_row);
+        for (std::size_t w = 0; w < m.words_per_row; ++w)
+            {
+                ancestral[w] = ~row[w];
+            }
+        // Clear the padding bits of the last word
+        const auto used = m.ncol % 64;
+        if (used != 0 && !ancestral.empty())
+            {
+                ancestral.back() &= (std::uint64_t{1} << used) - 1;
+            }
+    }
+
+    void
+    validate(const fwdpy11_core::packed_genotype_matrix &m)
+    {
+        if (m.packing != fwdpy11_core::genotype_packing::haplotype)
+            {
+                throw std::invalid_argument("haplotype statistics require haplotype "
+                                            "packing");
+            }
+        if (!std::is_sorted(begin(m.positions), end(m.positions)))
+            {
+                throw std::invalid_argument("row positions must be sorted");
+            }
+    }
+}
+
+namespace fwdpy11_core
+{
+    haplotype_scan_result
+    haplotype_scan(const packed_genotype_matrix &m, const haplotype_scan_options &options)
+    {
+        validate(m);
+        if (!(options.min_ehh >= 0.0 && options.min_ehh < 1.0))
+            {
+                throw std::invalid_argument("min_ehh must be in [0, 1)");
+            }
+        if (!(options.min_maf >= 0.0 && options.min_maf <= 0.5))
+            {
+                throw std::invalid_argument("min_maf must be in [0, 0.5]");
+            }
+        const auto nrow = m.nrow();
+        const auto counts = allele_counts(m);
+        haplotype_scan_result rv;
+        rv.ihh_ancestral.resize(nrow, NaN);
+        rv.ihh_derived.resize(nrow, NaN);
+        rv.ihs.resize(nrow, NaN);
+        rv.sl_ancestral.resize(nrow, NaN);
+        rv.sl_derived.resize(nrow, NaN);
+        rv.nsl.resize(nrow, NaN);
+
+        internal::run_in_blocks(
+            nrow, options.num_threads, [&](std::size_t, std::size_t first, std::size_t last) {
+                haplotype_groups groups(m.words_per_row);
+                std::vector<std::uint64_t> masks[2];
+                for (std::size_t core = first; core < last; ++core)
+                    {
+                        const double n = static_cast<double>(m.ncol);
+                        const double c = static_cast<double>(counts[core]);
+                        const double maf = std::min(c, n - c) / n;
+                        if (counts[core] < 2 || n - c < 2.0 || maf < options.min_maf)
+                            {
+                                continue;
+                            }
+                        allele_masks(m, core, masks[0], masks[1]);
+                        double ihh[2], sl[2];
+                        for (int a = 0; a < 2; ++a)
+                            {
+                                bool edge = false;
+                                ihh[a] = 0.0;
+                                // The core is shared by both sides
+                                sl[a] = 1.0;
+                                for (int direction : {-1, 1})
+                                    {
+                                        groups.reset(masks[a]);
+                                        const auto side = walk(m, core, direction,
+                                                               options.min_ehh, groups);
+                                        ihh[a] += side.ihh;
+                                        sl[a] += side.sl;
+                                        edge = edge || !side.reached_min_ehh;
+                                    }
+                                if (edge && !options.include_edges)
+                                    {
+                                        ihh[a] = NaN;
+                                    }
+                            }
+                        rv.ihh_ancestral[core] = ihh[0];
+                        rv.ihh_derived[core] = ihh[1];
+                        rv.ihs[core] = std::log(ihh[0] / ihh[1]);
+                        rv.sl_ancestral[core] = sl[0];
+                        rv.sl_derived[core] = sl[1];
+                        rv.nsl[core] = std::log(sl[0] / sl[1]);
+                    }
+            });
+        return rv;
+    }
+
+    void
+    ehh_decay(const packed_genotype_matrix &m, std::size_t core,
+              std::vector<double> &ehh_ancestral, std::vector<double> &ehh_derived)
+    {
+        validate(m);
+        if (core >= m.nrow())
+            {
+                throw std::invalid_argument("core row is out of range");
+            }
+        std::vector<std::uint64_t> masks[2];
+        allele_masks(m, core, masks[0], masks[1]);
+        std::vector<double> *out[2] = {&ehh_ancestral, &ehh_derived};
+        haplotype_groups groups(m.words_per_row);
+        for (int a = 0; a < 2; ++a)
+            {
+                groups.reset(masks[a]);
+                if (groups.empty())
+                    {
+                        out[a]->assign(m.nrow(), NaN);
+                        continue;
+                    }
+                out[a]->assign(m.nrow(), 0.0);
+                (*out[a])[core] = 1.0;
+                for (int direction : {-1, 1})
+                    {
+                        groups.reset(masks[a]);
+                        auto row = static_cast<std::ptrdiff_t>(core) + direction;
+                        for (; row >= 0 && row < static_cast<std::ptrdiff_t>(m.nrow())
+                               && !groups.empty();
+                             row += direction)
+                            {
+                                groups.split(m.data.data() + row * m.words_per_row);
+                                (*out[a])[row] = groups.ehh();
+                            }
+                    }
+            }
+    }
+}
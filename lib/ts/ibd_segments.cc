@@ -0,0 +1,270 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+#include <core/ts/ibd_segments.hpp>
+
+namespace
+{
+    using fwdpp::ts::table_index_t;
+
+    struct ancestral_segment
+    {
+        double left, right;
+        table_index_t sample;
+        // The child of the current parent that
+        // the segment was inherited through.
+        table_index_t child;
+    };
+
+    struct ibd_piece
+    {
+        table_index_t first, second;
+        double left, right;
+    };
+
+    std::uint64_t
+    pair_key(table_index_t a, table_index_t b)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(std::min(a, b)))
+                << 32)
+               | static_cast<std::uint32_t>(std::max(a, b));
+    }
+
+    void
+    validate_node(table_index_t u, std::size_t nnodes)
+    {
+        if (u < 0 || static_cast<std::size_t>(u) >= nnodes)
+            {
+                throw std::invalid_argument("sample node is out of range");
+            }
+    }
+
+    std::vector<ancestral_segment>
+    squash(std::vector<ancestral_segment> &segments)
+    // Merges adjacent intervals of the same sample.
+    {
+        std::sort(begin(segments), end(segments),
+                  [](const ancestral_segment &a, const ancestral_segment &b) {
+                      return a.sample < b.sample
+                             || (a.sample == b.sample && a.left < b.left);
+                  });
+        std::vector<ancestral_segment> rv;
+        for (auto &s : segments)
+            {
+                if (!rv.empty() && rv.back().sample == s.sample
+                    && rv.back().right == s.left)
+                    {
+                        rv.back().right = s.right;
+                    }
+                else
+                    {
+                        rv.push_back(s);
+                    }
+            }
+        return rv;
+    }
+}
+
+namespace fwdpy11_core
+{
+    ibd_segments
+    find_ibd_segments(
+        const fwdpp::ts::std_table_collection &tables,
+        const std::vector<table_index_t> &samples,
+        const std::vector<std::pair<table_index_t, table_index_t>> &pairs,
+        double min_length)
+    {
+        if (!(min_length >= 0.0))
+            {
+                throw std::invalid_argument("min_length must be >= 0");
+            }
+        const auto nnodes = tables.nodes.size();
+        const auto &edges = tables.edges;
+        for (const auto &e : edges)
+            {
+                if (e.parent < 0 || static_cast<std::size_t>(e.parent) >= nnodes
+                    || e.child < 0 || static_cast<std::size_t>(e.child) >= nnodes)
+                    {
+                        throw std::invalid_argument("edge refers to an invalid node");
+                    }
+            }
+
+        std::vector<std::vector<ancestral_segment>> ancestry(nnodes);
+        std::vector<char> is_sample(nnodes, 0);
+        std::unordered_set<std::uint64_t> wanted;
+        const auto add_sample = [&](table_index_t u) {
+            validate_node(u, nnodes);
+            if (!is_sample[u])
+                {
+                    is_sample[u] = 1;
+                    ancestry[u].push_back(
+                        ancestral_segment{0.0, tables.genome_length(), u, u});
+                }
+        };
+        if (pairs.empty())
+            {
+                for (auto u : samples)
+                    {
+                        validate_node(u, nnodes);
+                        if (is_sample[u])
+                            {
+                                throw std::invalid_argument("duplicate sample nodes");
+                            }
+                        add_sample(u);
+                    }
+            }
+        else
+            {
+                for (auto &p : pairs)
+                    {
+                        if (p.first == p.second)
+                            {
+                                throw std::invalid_argument(
+                                    "the nodes in a pair must differ");
+                            }
+                        add_sample(p.first);
+                        add_sample(p.second);
+                        wanted.insert(pair_key(p.first, p.second));
+                    }
+            }
+        const auto is_wanted = [&wanted](table_index_t a, table_index_t b) {
+            return wanted.empty() || wanted.count(pair_key(a, b)) > 0;
+        };
+
+        // Edges grouped by parent, youngest parent first.
+        // Node times increase forwards in time.
+        std::vector<std::size_t> order(edges.size());
+        std::iota(begin(order), end(order), 0);
+        std::sort(begin(order), end(order), [&](std::size_t i, std::size_t j) {
+            const auto &a = edges[i], &b = edges[j];
+            const double ta = tables.nodes[a.parent].time,
+                         tb = tables.nodes[b.parent].time;
+            if (ta != tb)
+                {
+                    return ta > tb;
+                }
+            if (a.parent != b.parent)
+                {
+                    return a.parent < b.parent;
+                }
+            if (a.child != b.child)
+                {
+                    return a.child < b.child;
+                }
+            return a.left < b.left;
+        });
+        std::vector<std::size_t> edges_above(nnodes, 0);
+        for (const auto &e : edges)
+            {
+                ++edges_above[e.child];
+            }
+
+        ibd_segments rv;
+        std::vector<ancestral_segment> incoming, active;
+        std::vector<ibd_piece> pieces;
+        std::size_t i = 0;
+        while (i < order.size())
+            {
+                const auto parent = edges[order[i]].parent;
+                incoming.swap(ancestry[parent]);
+                ancestry[parent].clear();
+                for (; i < order.size() && edges[order[i]].parent == parent; ++i)
+                    {
+                        const auto &e = edges[order[i]];
+                        for (const auto &s : ancestry[e.child])
+                            {
+                                if (s.right > e.left && s.left < e.right)
+                                    {
+                                        incoming.push_back(ancestral_segment{
+                                            std::max(s.left, e.left),
+                                            std::min(s.right, e.right), s.sample,
+                                            e.child});
+                                    }
+                            }
+                        if (--edges_above[e.child] == 0)
+                            {
+                                ancestry[e.child].clear();
+                                ancestry[e.child].shrink_to_fit();
+                            }
+                    }
+                if (incoming.empty())
+                    {
+                        continue;
+                    }
+
+                // Sweep from left to right.  Overlapping intervals
+                // from different children coalesce here.
+                std::sort(begin(incoming), end(incoming),
+                          [](const ancestral_segment &a, const ancestral_segment &b) {
+                              return a.left < b.left;
+                          });
+                active.clear();
+                pieces.clear();
+                for (const auto &s : incoming)
+                    {
+                        active.erase(std::remove_if(begin(active), end(active),
+                                                    [&s](const ancestral_segment &a) {
+                                                        return a.right <= s.left;
+                                                    }),
+                                     end(active));
+                        for (const auto &a : active)
+                            {
+                                if (a.child != s.child && a.sample != s.sample
+                                    && is_wanted(a.sample, s.sample))
+                                    {
+                                        pieces.push_back(ibd_piece{
+                                            std::min(a.sample, s.sample),
+                                            std::max(a.sample, s.sample), s.left,
+                                            std::min(a.right, s.right)});
+                                    }
+                            }
+                        active.push_back(s);
+                    }
+
+                // All pieces found here share the MRCA, so adjacent
+                // pieces for the same pair are one segment.
+                std::sort(begin(pieces), end(pieces),
+                          [](const ibd_piece &a, const ibd_piece &b) {
+                              if (a.first != b.first)
+                                  {
+                                      return a.first < b.first;
+                                  }
+                              if (a.second != b.second)
+                                  {
+                                      return a.second < b.second;
+                                  }
+                              return a.left < b.left;
+                          });
+                for (std::size_t j = 0; j < pieces.size();)
+                    {
+                        auto segment = pieces[j++];
+                        while (j < pieces.size() && pieces[j].first == segment.first
+                               && pieces[j].second == segment.second
+                               && pieces[j].left == segment.right)
+                            {
+                                segment.right = pieces[j++].right;
+                            }
+                        if (segment.right - segment.left >= min_length)
+                            {
+                                rv.first.push_back(segment.first);
+                                rv.second.push_back(segment.second);
+                                rv.left.push_back(segment.left);
+                                rv.right.push_back(segment.right);
+                                rv.node.push_back(parent);
+                                rv.time.push_back(tables.nodes[parent].time);
+                            }
+                    }
+                ancestry[parent] = squash(incoming);
+                incoming.clear();
+                if (edges_above[parent] == 0)
+                    {
+                        ancestry[parent].clear();
+                        ancestry[parent].shrink_to_fit();
+                    }
+            }
+        return rv;
+    }
+}
@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <core/ts/linkage_disequilibrium.hpp>
+#include "bit_operations.hpp"
+#include "parallel_blocks.hpp"
+
+namespace
+{
+    using fwdpy11_core::linkage_disequilibrium_pairs;
+
+    void
+    append_pair(std::uint32_t i, std::uint32_t j, double n, double ci, double cj,
+                double cij, linkage_disequilibrium_pairs &rv)
+    {
+        const double pi = ci / n, pj = cj / n;
+        const double D = cij / n - pi * pj;
+        double r2 = std::numeric_limits<double>::quiet_NaN();
+        double Dprime = std::numeric_limits<double>::quiet_NaN();
+        const double denom = pi * (1.0 - pi) * pj * (1.0 - pj);
+        if (denom > 0.0)
+            {
+                r2 = D * D / denom;
+                const double Dmax = D >= 0.0
+                                        ? std::min(pi * (1.0 - pj), (1.0 - pi) * pj)
+                                        : std::min(pi * pj, (1.0 - pi) * (1.0 - pj));
+                Dprime = D / Dmax;
+            }
+        rv.first.push_back(i);
+        rv.second.push_back(j);
+        rv.D.push_back(D);
+        rv.r2.push_back(r2);
+        rv.Dprime.push_back(Dprime);
+    }
+}
+
+namespace fwdpy11_core
+{
+    linkage_disequilibrium_pairs
+    linkage_disequilibrium(const packed_genotype_matrix &m, std::size_t max_sites_apart,
+                           double max_distance, std::size_t num_threads)
+    {
+        if (m.packing != genotype_packing::haplotype)
+            {
+                throw std::invalid_argument("linkage disequilibrium requires haplotype "
+                                            "packing");
+            }
+        if (std::isnan(max_distance) || max_distance < 0.0)
+            {
+                throw std::invalid_argument("max_distance must be >= 0");
+            }
+        if (!std::is_sorted(begin(m.positions), end(m.positions)))
+            {
+                throw std::invalid_argument("row positions must be sorted");
+            }
+        if (m.nrow() > std::numeric_limits<std::uint32_t>::max())
+            {
+                throw std::invalid_argument("too many rows");
+            }
+        const auto counts = allele_counts(m);
+        const auto n = static_cast<double>(m.ncol);
+        const auto nrow = m.nrow();
+        const auto words = m.words_per_row;
+
+        std::vector<linkage_disequilibrium_pairs> blocks(
+            std::max<std::size_t>(1, std::min(num_threads, nrow)));
+        internal::run_in_blocks(
+            nrow, num_threads,
+            [&](std::size_t block, std::size_t first, std::size_t last) {
+                auto &out = blocks[block];
+                for (std::size_t i = first; i < last; ++i)
+                    {
+                        const auto *a = m.data.data() + i * words;
+                        for (std::size_t j = i + 1;
+                             j < nrow && j - i <= max_sites_apart
+                             && m.positions[j] - m.positions[i] <= max_distance;
+                             ++j)
+                            {
+                                const auto *b = m.data.data() + j * words;
+                                unsigned cij = 0;
+                                for (std::size_t w = 0; w < words; ++w)
+                                    {
+                                        cij += internal::popcount(a[w] & b[w]);
+                                    }
+                                append_pair(static_cast<std::uint32_t>(i),
+                                            static_cast<std::uint32_t>(j), n,
+                                            counts[i], counts[j], cij, out);
+                            }
+                    }
+            });
+        if (blocks.size() == 1)
+            {
+                return std::move(blocks[0]);
+            }
+        linkage_disequilibrium_pairs rv;
+        std::size_t npairs = 0;
+        for (auto &b : blocks)
+            {
+                npairs += b.first.size();
+            }
+        rv.first.reserve(npairs);
+        rv.second.reserve(npairs);
+        rv.D.reserve(npairs);
+        rv.r2.reserve(npairs);
+        rv.Dprime.reserve(npairs);
+        for (auto &b : blocks)
+            {
+                rv.first.insert(end(rv.first), begin(b.first), end(b.first));
+                rv.second.insert(end(rv.second), begin(b.second), end(b.second));
+                rv.D.insert(end(rv.D), begin(b.D), end(b.D));
+                rv.r2.insert(end(rv.r2), begin(b.r2), end(b.r2));
+                rv.Dprime.insert(end(rv.Dprime), begin(b.Dprime), end(b.Dprime));
+                b = linkage_disequilibrium_pairs{};
+            }
+        return rv;
+    }
+}
@@ -0,0 +1,345 @@
+#include <algorithm>
+#include <stdexcept>
+#include <fwdpp/ts/tree_visitor.hpp>
+#include <fwdpp/ts/detail/generate_data_matrix_details.hpp>
+#include <core/ts/packed_genotype_matrix.hpp>
+#include "bit_operations.hpp"
+
+namespace
+{
+    using fwdpy11_core::internal::LOW_BITS;
+    using fwdpy11_core::internal::lowest_set_bit;
+    using fwdpy11_core::internal::popcount;
+
+    inline std::size_t
+    number_of_words(std::size_t nentries, std::size_t bits_per_entry)
+    {
+        return (nentries * bits_per_entry + 63) / 64;
+    }
+
+    // Sum of 2-bit values in a word
+    inline unsigned
+    dosage_sum(std::uint64_t w)
+    {
+        return popcount(w & LOW_BITS) + 2 * popcount((w >> 1) & LOW_BITS);
+    }
+
+    // Sum over entries of |a - b|, where a and b
+    // are dosages in {0, 1, 2}.  The XOR of two
+    // dosages is 01 or 11 if they differ by one
+    // and 10 if they differ by two.
+    inline unsigned
+    dosage_distance(std::uint64_t a, std::uint64_t b)
+    {
+        const auto x = a ^ b;
+        const auto lo = x & LOW_BITS, hi = (x >> 1) & LOW_BITS;
+        return popcount(lo) + 2 * popcount(hi & ~lo);
+    }
+
+    void
+    append_state_matrix(const fwdpp::state_matrix &sm,
+                        const std::vector<std::size_t> &keys, std::size_t nsamples,
+                        fwdpy11_core::packed_genotype_matrix &m)
+    {
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            {
+                m.append_row(sm.data.data() + i * nsamples, sm.positions[i], keys[i]);
+            }
+    }
+
+    std::vector<std::uint64_t>
+    transpose(const fwdpy11_core::packed_genotype_matrix &m, std::size_t &words_per_col)
+    // Column-major copy, so that each column is a
+    // contiguous run of words.  Each word of a row is
+    // read once and only its non-zero entries are moved.
+    {
+        const auto bits = m.bits_per_entry();
+        const unsigned entries_per_word = 64 / bits;
+        words_per_col = number_of_words(m.nrow(), bits);
+        std::vector<std::uint64_t> rv(words_per_col * m.ncol, 0);
+        for (std::size_t r = 0; r < m.nrow(); ++r)
+            {
+                const auto row = m.data.data() + r * m.words_per_row;
+                const auto word = r * bits / 64;
+                const auto shift = r * bits % 64;
+                for (std::size_t w = 0; w < m.words_per_row; ++w)
+                    {
+                        // One set bit at the lowest bit
+                        // of each non-zero entry
+                        auto nonzero
+                            = bits == 1 ? row[w] : (row[w] | (row[w] >> 1)) & LOW_BITS;
+                        while (nonzero)
+                            {
+                                const auto b = lowest_set_bit(nonzero);
+                                const auto c = w * entries_per_word + b / bits;
+                                const std::uint64_t v
+                                    = (row[w] >> b) & (bits == 1 ? 1u : 3u);
+                                rv[c * words_per_col + word] |= v << shift;
+                                nonzero &= nonzero - 1;
+                            }
+                    }
+            }
+        return rv;
+    }
+}
+
+namespace fwdpy11_core
+{
+    genotype_packing
+    genotype_packing_from_string(const std::string &packing)
+    {
+        if (packing == "haplotype")
+            {
+                return genotype_packing::haplotype;
+            }
+        if (packing == "dosage")
+            {
+                return genotype_packing::dosage;
+            }
+        throw std::invalid_argument("packing must be \"haplotype\" or \"dosage\"");
+    }
+
+    packed_genotype_matrix::packed_genotype_matrix(genotype_packing p,
+                                                   std::size_t nsamples)
+        : packing(p), ncol(p == genotype_packing::haplotype ? nsamples : nsamples / 2),
+          words_per_row(number_of_words(ncol, bits_per_entry())), data{}, positions{},
+          keys{}
+    {
+        if (p == genotype_packing::dosage && nsamples % 2 != 0)
+            {
+                throw std::invalid_argument(
+                    "dosages require an even number of sampled nodes");
+            }
+    }
+
+    void
+    packed_genotype_matrix::append_row(const std::int8_t *haplotypes, double position,
+                                       std::size_t key)
+    {
+        const auto offset = data.size();
+        data.resize(offset + words_per_row, 0);
+        auto row = data.data() + offset;
+        const auto bits = bits_per_entry();
+        for (std::size_t c = 0; c < ncol; ++c)
+            {
+                std::uint64_t v;
+                if (packing == genotype_packing::haplotype)
+                    {
+                        v = static_cast<std::uint64_t>(haplotypes[c] != 0);
+                    }
+                else
+                    {
+                        v = static_cast<std::uint64_t>(haplotypes[2 * c] != 0)
+                            + static_cast<std::uint64_t>(haplotypes[2 * c + 1] != 0);
+                    }
+                const auto bit = c * bits;
+                row[bit / 64] |= v << (bit % 64);
+            }
+        positions.push_back(position);
+        keys.push_back(key);
+    }
+
+    unsigned
+    packed_genotype_matrix::get(std::size_t row, std::size_t col) const
+    {
+        if (row >= nrow() || col >= ncol)
+            {
+                throw std::out_of_range("packed genotype index out of range");
+            }
+        const auto bits = bits_per_entry();
+        const auto bit = col * bits;
+        const auto w = data[row * words_per_row + bit / 64];
+        return static_cast<unsigned>((w >> (bit % 64)) & ((1ULL << bits) - 1));
+    }
+
+    packed_data_matrix
+    pack_data_matrix(const fwdpp::data_matrix &dm, genotype_packing packing)
+    {
+        packed_data_matrix rv(packing, dm.ncol);
+        append_state_matrix(dm.neutral, dm.neutral_keys, dm.ncol, rv.neutral);
+        append_state_matrix(dm.selected, dm.selected_keys, dm.ncol, rv.selected);
+        return rv;
+    }
+
+    packed_data_matrix
+    packed_data_matrix_from_tables(const fwdpp::ts::std_table_collection &tables,
+                                   const std::vector<fwdpp::ts::table_index_t> &samples,
+                                   bool record_neutral, bool record_selected,
+                                   bool include_fixations, double start, double stop,
+                                   genotype_packing packing)
+    {
+        if (!(stop > start))
+            {
+                throw std::invalid_argument("invalid interval: end <= beg");
+            }
+        packed_data_matrix rv(packing, samples.size());
+        // Holds the rows for one site at a time
+        fwdpp::data_matrix scratch(samples.size());
+        std::vector<std::int8_t> genotypes(samples.size(), 0);
+        const auto sbeg = begin(tables.sites), send = end(tables.sites);
+        const auto mbeg = begin(tables.mutations), mend = end(tables.mutations);
+        auto s = std::lower_bound(sbeg, send, start,
+                                  [](const fwdpp::ts::site &site, double v) {
+                                      return site.position < v;
+                                  });
+        auto m = mbeg;
+        if (s < send)
+            {
+                m = std::lower_bound(
+                    mbeg, mend, s->position,
+                    [sbeg](const fwdpp::ts::mutation_record &mr, double p) {
+                        return (sbeg + mr.site)->position < p;
+                    });
+            }
+        fwdpp::ts::tree_visitor<fwdpp::ts::std_table_collection> tv(
+            tables, samples, fwdpp::ts::update_samples_list(true));
+        while (s < send && s->position < stop && tv())
+            {
+                const auto &tree = tv.tree();
+                for (; s < send && s->position < tree.right && s->position < stop; ++s)
+                    {
+                        auto mlast = m;
+                        while (mlast < mend
+                               && (sbeg + mlast->site)->position == s->position)
+                            {
+                                ++mlast;
+                            }
+                        fwdpp::ts::detail::process_site_range(
+                            tree, s, std::make_pair(m, mlast), record_neutral,
+                            record_selected, !include_fixations, genotypes, scratch);
+                        m = mlast;
+                        append_state_matrix(scratch.neutral, scratch.neutral_keys,
+                                            samples.size(), rv.neutral);
+                        append_state_matrix(scratch.selected, scratch.selected_keys,
+                                            samples.size(), rv.selected);
+                        scratch.neutral_keys.clear();
+                        scratch.selected_keys.clear();
+                        scratch.neutral.data.clear();
+                        scratch.neutral.positions.clear();
+                        scratch.selected.data.clear();
+                        scratch.selected.positions.clear();
+                    }
+            }
+        return rv;
+    }
+
+    packed_genotype_matrix
+    merge_by_position(const packed_genotype_matrix &a, const packed_genotype_matrix &b)
+    {
+        if (a.packing != b.packing || a.ncol != b.ncol)
+            {
+                throw std::invalid_argument(
+                    "matrices must have the same packing and number of columns");
+            }
+        packed_genotype_matrix rv(a);
+        rv.data.clear();
+        rv.positions.clear();
+        rv.keys.clear();
+        rv.data.reserve(a.data.size() + b.data.size());
+        rv.positions.reserve(a.nrow() + b.nrow());
+        rv.keys.reserve(a.nrow() + b.nrow());
+        const auto append = [&rv](const packed_genotype_matrix &m, std::size_t r) {
+            auto row = begin(m.data) + r * m.words_per_row;
+            rv.data.insert(end(rv.data), row, row + m.words_per_row);
+            rv.positions.push_back(m.positions[r]);
+            rv.keys.push_back(m.keys[r]);
+        };
+        std::size_t i = 0, j = 0;
+        while (i < a.nrow() || j < b.nrow())
+            {
+                if (j == b.nrow() || (i < a.nrow() && a.positions[i] <= b.positions[j]))
+                    {
+                        append(a, i++);
+                    }
+                else
+                    {
+                        append(b, j++);
+                    }
+            }
+        return rv;
+    }
+
+    std::vector<std::uint32_t>
+    allele_counts(const packed_genotype_matrix &m)
+    {
+        std::vector<std::uint32_t> rv(m.nrow(), 0);
+        for (std::size_t r = 0; r < m.nrow(); ++r)
+            {
+                auto row = m.data.data() + r * m.words_per_row;
+                std::uint32_t count = 0;
+                for (std::size_t w = 0; w < m.words_per_row; ++w)
+                    {
+                        count += m.packing == genotype_packing::haplotype
+                                     ? popcount(row[w])
+                                     : dosage_sum(row[w]);
+                    }
+                rv[r] = count;
+            }
+        return rv;
+    }
+
+    std::vector<std::uint32_t>
+    heterozygous_sites(const packed_genotype_matrix &m)
+    {
+        // A word holds whole individuals for either packing:
+        // 32 pairs of haplotypes or 32 dosages.
+        std::size_t nindividuals = m.ncol;
+        if (m.packing == genotype_packing::haplotype)
+            {
+                if (m.ncol % 2 != 0)
+                    {
+                        throw std::invalid_argument(
+                            "heterozygosity requires an even number of haplotypes");
+                    }
+                nindividuals = m.ncol / 2;
+            }
+        std::vector<std::uint32_t> rv(nindividuals, 0);
+        for (std::size_t r = 0; r < m.nrow(); ++r)
+            {
+                auto row = m.data.data() + r * m.words_per_row;
+                for (std::size_t w = 0; w < m.words_per_row; ++w)
+                    {
+                        std::uint64_t het;
+                        if (m.packing == genotype_packing::haplotype)
+                            {
+                                het = (row[w] ^ (row[w] >> 1)) & LOW_BITS;
+                            }
+                        else
+                            {
+                                het = row[w] & LOW_BITS & ~((row[w] >> 1) & LOW_BITS);
+                            }
+                        while (het)
+                            {
+                                rv[w * 32 + lowest_set_bit(het) / 2]++;
+                                het &= het - 1;
+                            }
+                    }
+            }
+        return rv;
+    }
+
+    std::vector<std::uint32_t>
+    pairwise_differences(const packed_genotype_matrix &m)
+    {
+        std::size_t words_per_col;
+        const auto columns = transpose(m, words_per_col);
+        std::vector<std::uint32_t> rv(m.ncol * m.ncol, 0);
+        for (std::size_t i = 0; i < m.ncol; ++i)
+            {
+                const auto a = columns.data() + i * words_per_col;
+                for (std::size_t j = i + 1; j < m.ncol; ++j)
+                    {
+                        const auto b = columns.data() + j * words_per_col;
+                        std::uint32_t d = 0;
+                        for (std::size_t w = 0; w < words_per_col; ++w)
+                            {
+                                d += m.packing == genotype_packing::haplotype
+                                         ? popcount(a[w] ^ b[w])
+                                         : dosage_distance(a[w], b[w]);
+                            }
+                        rv[i * m.ncol + j] = rv[j * m.ncol + i] = d;
+                    }
+            }
+        return rv;
+    }
+}
@@ -0,0 +1,66 @@
+#ifndef FWDPY11_TS_PARALLEL_BLOCKS_HPP
+#define FWDPY11_TS_PARALLEL_BLOCKS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace fwdpy11_core
+{
+    namespace internal
+    {
+        template <typename F>
+        void
+        run_in_blocks(std::size_t n, std::size_t num_threads, const F &f)
+        // Splits [0, n) into at most num_threads contiguous blocks and
+        // calls f(block, first, last) for each block in its own thread.
+        // If there is one block, f is called in the calling thread.
+        // The first exception thrown by any block is rethrown
+        // once all threads have finished.
+        {
+            if (num_threads == 0)
+                {
+                    throw std::invalid_argument("number of threads must be > 0");
+                }
+            const auto nblocks = std::max<std::size_t>(1, std::min(num_threads, n));
+            if (nblocks == 1)
+                {
+                    f(std::size_t{0}, std::size_t{0}, n);
+                    return;
+                }
+            std::vector<std::exception_ptr> errors(nblocks, nullptr);
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < nblocks; ++i)
+                {
+                    const auto first = i * n / nblocks;
+                    const auto last = (i + 1) * n / nblocks;
+                    threads.emplace_back([&f, &errors, i, first, last]() {
+                        try
+                            {
+                                f(i, first, last);
+                            }
+                        catch (...)
+                            {
+                                errors[i] = std::current_exception();
+                            }
+                    });
+                }
+            for (auto &t : threads)
+                {
+                    t.join();
+                }
+            for (auto &e : errors)
+                {
+                    if (e != nullptr)
+                        {
+                            std::rethrow_exception(e);
+                        }
+                }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,355 @@
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <fwdpp/ts/table_simplifier.hpp>
+#include <core/ts/partitioned_simplification.hpp>
+#include "parallel_blocks.hpp"
+
+namespace
+{
+    struct simplified_interval
+    {
+        fwdpp::ts::std_table_collection tables;
+        // If local_ids is true, node i of tables is
+        // node input_ids[i] of the input.  Otherwise,
+        // tables uses the input node ids.
+        bool local_ids;
+        std::vector<fwdpp::ts::table_index_t> input_ids;
+        // Maps node ids in tables before simplification to ids after
+        std::vector<fwdpp::ts::table_index_t> idmap;
+        std::vector<std::size_t> preserved_mutations;
+
+        explicit simplified_interval(double genome_length)
+            : tables(genome_length), local_ids(true), input_ids{}, idmap{},
+              preserved_mutations{}
+        {
+        }
+
+        fwdpp::ts::table_index_t
+        input_id(std::size_t i) const
+        {
+            return local_ids ? input_ids[i] : static_cast<fwdpp::ts::table_index_t>(i);
+        }
+    };
+
+    std::vector<double>
+    edge_balanced_breakpoints(const fwdpp::ts::std_table_collection &tables,
+                              std::size_t num_partitions)
+    // Returns num_partitions + 1 (or fewer) breakpoints.
+    // The interior breakpoints are quantiles of the
+    // distribution of edge left coordinates.
+    {
+        std::vector<double> lefts;
+        lefts.reserve(tables.edges.size());
+        for (const auto &e : tables.edges)
+            {
+                lefts.push_back(e.left);
+            }
+        std::vector<double> breakpoints{0.0};
+        auto first = begin(lefts);
+        for (std::size_t i = 1; i < num_partitions && !lefts.empty(); ++i)
+            {
+                auto q = begin(lefts) + i * lefts.size() / num_partitions;
+                std::nth_element(first, q, end(lefts));
+                if (*q > breakpoints.back() && *q < tables.genome_length())
+                    {
+                        breakpoints.push_back(*q);
+                    }
+                first = q;
+            }
+        breakpoints.push_back(tables.genome_length());
+        return breakpoints;
+    }
+
+    void
+    partition_tables(const fwdpp::ts::std_table_collection &input,
+                     const std::vector<double> &breakpoints,
+                     std::vector<simplified_interval> &intervals)
+    // Gives each interval the edges, sites and mutations that
+    // overlap it, in one pass over each table.  Rows keep their
+    // input order, so each interval's tables remain sorted.
+    // The node ids used by each interval are recorded in input_ids.
+    {
+        // Searching the interior breakpoints means that positions
+        // outside of [0, genome_length) go to the first or last interval.
+        const auto interval_of = [&breakpoints](double x) {
+            return static_cast<std::size_t>(std::upper_bound(begin(breakpoints) + 1,
+                                                             end(breakpoints) - 1, x)
+                                            - begin(breakpoints))
+                   - 1;
+        };
+        for (const auto &e : input.edges)
+            {
+                for (auto i = interval_of(e.left);
+                     i < intervals.size() && breakpoints[i] < e.right; ++i)
+                    {
+                        // Clipping does not change the sort order.
+                        intervals[i].tables.edges.push_back(fwdpp::ts::edge{
+                            std::max(e.left, breakpoints[i]),
+                            std::min(e.right, breakpoints[i + 1]), e.parent, e.child});
+                        intervals[i].input_ids.push_back(e.parent);
+                        intervals[i].input_ids.push_back(e.child);
+                    }
+            }
+        std::vector<std::size_t> site_interval(input.sites.size());
+        std::vector<fwdpp::ts::table_index_t> site_map(input.sites.size());
+        for (std::size_t i = 0; i < input.sites.size(); ++i)
+            {
+                site_interval[i] = interval_of(input.sites[i].position);
+                auto &interval = intervals[site_interval[i]];
+                site_map[i] = static_cast<fwdpp::ts::table_index_t>(
+                    interval.tables.sites.size());
+                interval.tables.sites.push_back(input.sites[i]);
+            }
+        for (const auto &m : input.mutations)
+            {
+                auto &interval = intervals[site_interval[m.site]];
+                interval.tables.mutations.push_back(m);
+                interval.tables.mutations.back().site = site_map[m.site];
+                interval.input_ids.push_back(m.node);
+            }
+    }
+
+    void
+    simplify_interval(const fwdpp::ts::std_table_collection::node_table &input_nodes,
+                      const std::vector<fwdpp::ts::table_index_t> &samples,
+                      simplified_interval &interval)
+    {
+        if (!interval.local_ids)
+            {
+                fwdpp::ts::table_simplifier<fwdpp::ts::std_table_collection>
+                    simplifier{};
+                auto rv = simplifier.simplify(interval.tables, samples);
+                interval.idmap.swap(rv.first);
+                interval.preserved_mutations.swap(rv.second);
+                return;
+            }
+        // Only copy the nodes used by this interval.
+        // Local ids follow input ids, so sorted tables stay sorted.
+        auto &ids = interval.input_ids;
+        ids.insert(end(ids), begin(samples), end(samples));
+        std::sort(begin(ids), end(ids));
+        ids.erase(std::unique(begin(ids), end(ids)), end(ids));
+        const auto local_id = [&ids](fwdpp::ts::table_index_t u) {
+            return static_cast<fwdpp::ts::table_index_t>(
+                std::lower_bound(begin(ids), end(ids), u) - begin(ids));
+        };
+        interval.tables.nodes.reserve(ids.size());
+        for (auto u : ids)
+            {
+                interval.tables.nodes.push_back(input_nodes[u]);
+            }
+        for (auto &e : interval.tables.edges)
+            {
+                e.parent = local_id(e.parent);
+                e.child = local_id(e.child);
+            }
+        for (auto &m : interval.tables.mutations)
+            {
+                m.node = local_id(m.node);
+            }
+        std::vector<fwdpp::ts::table_index_t> local_samples;
+        local_samples.reserve(samples.size());
+        for (auto s : samples)
+            {
+                local_samples.push_back(local_id(s));
+            }
+        fwdpp::ts::table_simplifier<fwdpp::ts::std_table_collection> simplifier{};
+        auto rv = simplifier.simplify(interval.tables, local_samples);
+        interval.idmap.swap(rv.first);
+        interval.preserved_mutations.swap(rv.second);
+    }
+
+    std::vector<fwdpp::ts::table_index_t>
+    make_global_idmap(const fwdpp::ts::std_table_collection &input,
+                      const std::vector<fwdpp::ts::table_index_t> &samples,
+                      const std::vector<simplified_interval> &intervals)
+    {
+        std::vector<char> retained(input.nodes.size(), 0);
+        for (const auto &interval : intervals)
+            {
+                for (std::size_t i = 0; i < interval.idmap.size(); ++i)
+                    {
+                        if (interval.idmap[i] != fwdpp::ts::NULL_INDEX)
+                            {
+                                retained[interval.input_id(i)] = 1;
+                            }
+                    }
+            }
+        std::vector<fwdpp::ts::table_index_t> idmap(input.nodes.size(),
+                                                    fwdpp::ts::NULL_INDEX);
+        fwdpp::ts::table_index_t next_id = 0;
+        for (auto s : samples)
+            {
+                idmap[s] = next_id++;
+                retained[s] = 0;
+            }
+        std::vector<fwdpp::ts::table_index_t> ancestors;
+        for (std::size_t i = 0; i < retained.size(); ++i)
+            {
+                if (retained[i])
+                    {
+                        ancestors.push_back(static_cast<fwdpp::ts::table_index_t>(i));
+                    }
+            }
+        std::sort(begin(ancestors), end(ancestors),
+                  [&input](fwdpp::ts::table_index_t a, fwdpp::ts::table_index_t b) {
+                      return std::make_tuple(-input.nodes[a].time, a)
+                             < std::make_tuple(-input.nodes[b].time, b);
+                  });
+        for (auto a : ancestors)
+            {
+                idmap[a] = next_id++;
+            }
+        return idmap;
+    }
+
+    void
+    stitch_intervals(const std::vector<fwdpp::ts::table_index_t> &idmap,
+                     std::vector<simplified_interval> &intervals,
+                     fwdpp::ts::std_table_collection &tables)
+    {
+        fwdpp::ts::std_table_collection::node_table nodes;
+        fwdpp::ts::std_table_collection::edge_table edges;
+        fwdpp::ts::std_table_collection::site_table sites;
+        fwdpp::ts::std_table_collection::mutation_table mutations;
+
+        for (std::size_t i = 0; i < idmap.size(); ++i)
+            {
+                if (idmap[i] != fwdpp::ts::NULL_INDEX)
+                    {
+                        if (static_cast<std::size_t>(idmap[i]) >= nodes.size())
+                            {
+                                nodes.resize(idmap[i] + 1);
+                            }
+                        nodes[idmap[i]] = tables.nodes[i];
+                    }
+            }
+
+        std::vector<fwdpp::ts::table_index_t> to_output;
+        for (auto &interval : intervals)
+            {
+                // Map the interval's output ids to the stitched output ids
+                to_output.assign(interval.tables.nodes.size(), fwdpp::ts::NULL_INDEX);
+                for (std::size_t i = 0; i < interval.idmap.size(); ++i)
+                    {
+                        if (interval.idmap[i] != fwdpp::ts::NULL_INDEX)
+                            {
+                                to_output[interval.idmap[i]]
+                                    = idmap[interval.input_id(i)];
+                            }
+                    }
+                for (const auto &e : interval.tables.edges)
+                    {
+                        edges.push_back(fwdpp::ts::edge{e.left, e.right,
+                                                        to_output[e.parent],
+                                                        to_output[e.child]});
+                    }
+                auto site_offset = static_cast<fwdpp::ts::table_index_t>(sites.size());
+                sites.insert(end(sites), begin(interval.tables.sites),
+                             end(interval.tables.sites));
+                for (auto m : interval.tables.mutations)
+                    {
+                        m.node = to_output[m.node];
+                        m.site += site_offset;
+                        mutations.push_back(m);
+                    }
+                // Release the memory as we go
+                interval.tables = fwdpp::ts::std_table_collection(tables.genome_length());
+                std::vector<fwdpp::ts::table_index_t>().swap(interval.input_ids);
+                std::vector<fwdpp::ts::table_index_t>().swap(interval.idmap);
+            }
+
+        std::sort(begin(edges), end(edges),
+                  [&nodes](const fwdpp::ts::edge &a, const fwdpp::ts::edge &b) {
+                      return std::make_tuple(-nodes[a.parent].time, a.parent, a.child,
+                                             a.left)
+                             < std::make_tuple(-nodes[b.parent].time, b.parent,
+                                               b.child, b.left);
+                  });
+        // Squash edges split at interval boundaries
+        std::size_t squashed = 0;
+        for (std::size_t i = 1; i < edges.size(); ++i)
+            {
+                auto &last = edges[squashed];
+                if (edges[i].parent == last.parent && edges[i].child == last.child
+                    && edges[i].left == last.right)
+                    {
+                        last.right = edges[i].right;
+                    }
+                else
+                    {
+                        edges[++squashed] = edges[i];
+                    }
+            }
+        if (!edges.empty())
+            {
+                edges.resize(squashed + 1);
+            }
+
+        tables.nodes.swap(nodes);
+        tables.edges.swap(edges);
+        tables.sites.swap(sites);
+        tables.mutations.swap(mutations);
+        tables.input_left.clear();
+        tables.output_right.clear();
+    }
+}
+
+std::pair<std::vector<fwdpp::ts::table_index_t>, std::vector<std::size_t>>
+partitioned_simplification(const std::vector<fwdpp::ts::table_index_t> &samples,
+                           std::size_t num_partitions,
+                           fwdpp::ts::std_table_collection &tables)
+{
+    if (num_partitions == 0)
+        {
+            throw std::invalid_argument("number of partitions must be > 0");
+        }
+    // Each partition gets its own thread, and more
+    // partitions than threads only add stitching work.
+    num_partitions = std::min<std::size_t>(
+        num_partitions, std::max(1u, std::thread::hardware_concurrency()));
+    auto breakpoints = edge_balanced_breakpoints(tables, num_partitions);
+    std::vector<simplified_interval> intervals(
+        breakpoints.size() - 1, simplified_interval(tables.genome_length()));
+    if (intervals.size() == 1)
+        {
+            // The interval is the whole genome, so move the
+            // rows instead of copying them.  The input nodes
+            // are needed again when stitching.
+            intervals[0].local_ids = false;
+            intervals[0].tables.nodes = tables.nodes;
+            intervals[0].tables.edges.swap(tables.edges);
+            intervals[0].tables.sites.swap(tables.sites);
+            intervals[0].tables.mutations.swap(tables.mutations);
+        }
+    else
+        {
+            partition_tables(tables, breakpoints, intervals);
+            // The rows now live in the intervals
+            fwdpp::ts::std_table_collection::edge_table().swap(tables.edges);
+            fwdpp::ts::std_table_collection::site_table().swap(tables.sites);
+            fwdpp::ts::std_table_collection::mutation_table().swap(tables.mutations);
+        }
+    fwdpy11_core::internal::run_in_blocks(
+        intervals.size(), intervals.size(),
+        [&tables, &samples, &intervals](std::size_t, std::size_t first,
+                                        std::size_t last) {
+            for (auto i = first; i < last; ++i)
+                {
+                    simplify_interval(tables.nodes, samples, intervals[i]);
+                }
+        });
+
+    auto idmap = make_global_idmap(tables, samples, intervals);
+    std::vector<std::size_t> preserved_mutations;
+    for (const auto &interval : intervals)
+        {
+            preserved_mutations.insert(end(preserved_mutations),
+                                       begin(interval.preserved_mutations),
+                                       end(interval.preserved_mutations));
+        }
+    stitch_intervals(idmap, intervals, tables);
+    return std::make_pair(std::move(idmap), std::move(preserved_mutations));
+}
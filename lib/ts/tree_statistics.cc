@@ -0,0 +1,664 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <core/ts/tree_statistics.hpp>
+
+namespace
+{
+    using sample_set_list = std::vector<std::vector<fwdpp::ts::table_index_t>>;
+
+    void
+    validate_windows(const std::vector<double> &windows, double genome_length)
+    {
+        if (windows.size() < 2)
+            {
+                throw std::invalid_argument("there must be at least one window");
+            }
+        if (!std::isfinite(windows.front()) || windows.front() < 0.0
+            || !std::isfinite(windows.back()) || windows.back() > genome_length)
+            {
+                throw std::invalid_argument(
+                    "windows must lie within the length of the genome");
+            }
+        for (std::size_t i = 1; i < windows.size(); ++i)
+            {
+                if (!(windows[i] > windows[i - 1]))
+                    {
+                        throw std::invalid_argument(
+                            "window breakpoints must be strictly increasing");
+                    }
+            }
+    }
+
+    std::vector<double>
+    sample_set_sizes(const sample_set_list &sample_sets, std::size_t nnodes)
+    {
+        if (sample_sets.empty())
+            {
+                throw std::invalid_argument("empty list of sample sets");
+            }
+        std::vector<double> rv;
+        for (auto &s : sample_sets)
+            {
+                if (s.empty())
+                    {
+                        throw std::invalid_argument("empty sample set");
+                    }
+                for (auto u : s)
+                    {
+                        if (u < 0 || static_cast<std::size_t>(u) >= nnodes)
+                            {
+                                throw std::invalid_argument(
+                                    "sample node is out of range");
+                            }
+                    }
+                rv.push_back(static_cast<double>(s.size()));
+            }
+        return rv;
+    }
+
+    // Returns the input and output orders of the edges,
+    // using the table indexes if they are present.
+    void
+    edge_orders(const fwdpp::ts::std_table_collection &tables,
+                std::vector<std::size_t> &insertion, std::vector<std::size_t> &removal)
+    {
+        const auto &edges = tables.edges;
+        if (tables.input_left.size() == edges.size()
+            && tables.output_right.size() == edges.size())
+            {
+                insertion.assign(begin(tables.input_left), end(tables.input_left));
+                removal.assign(begin(tables.output_right), end(tables.output_right));
+                return;
+            }
+        insertion.resize(edges.size());
+        removal.resize(edges.size());
+        std::iota(begin(insertion), end(insertion), 0);
+        std::iota(begin(removal), end(removal), 0);
+        std::stable_sort(begin(insertion), end(insertion),
+                         [&edges](std::size_t a, std::size_t b) {
+                             return edges[a].left < edges[b].left;
+                         });
+        std::stable_sort(begin(removal), end(removal),
+                         [&edges](std::size_t a, std::size_t b) {
+                             return edges[a].right < edges[b].right;
+                         });
+    }
+
+    struct afs_bins
+    // Output layout of allele_frequency_spectrum.
+    // Sample set k uses bins offsets[k] to offsets[k] + size.
+    {
+        std::vector<std::size_t> offsets;
+        bool fold;
+    };
+
+    class incremental_statistic
+    // Counts of samples from each sample set below each
+    // node in the current tree.  For branch mode, also the
+    // sum over branches of branch length times the summary
+    // of the counts below the branch.
+    //
+    // For the site frequency spectrum in branch mode, each
+    // branch adds its length to one bin per sample set, so
+    // the bins are updated directly from the counts.  This
+    // avoids storing output_dim values per node and calling
+    // the summary for every ancestor of every edge.
+    {
+      private:
+        const fwdpp::ts::std_table_collection &tables;
+        const std::size_t nsets, output_dim;
+        const std::vector<double> &sizes;
+        const fwdpy11_core::tree_statistic_summary &summary;
+        const bool polarised, track_branches;
+        const afs_bins *afs;
+        std::vector<double> complement, scratch;
+        // For branch mode, the summary of each node's counts.
+        std::vector<double> node_summaries;
+
+        double
+        branch_length(fwdpp::ts::table_index_t u) const
+        {
+            // Node times increase forwards in time.
+            return tables.nodes[u].time - tables.nodes[parents[u]].time;
+        }
+
+        void
+        adjust_total(fwdpp::ts::table_index_t u, double sign)
+        {
+            if (parents[u] == fwdpp::ts::NULL_INDEX)
+                {
+                    return;
+                }
+            const double w = sign * branch_length(u);
+            if (afs != nullptr)
+                {
+                    const double *x = counts.data() + u * nsets;
+                    for (std::size_t k = 0; k < nsets; ++k)
+                        {
+                            auto c = static_cast<std::size_t>(x[k]);
+                            const auto n = static_cast<std::size_t>(sizes[k]);
+                            if (c == 0 || c == n)
+                                {
+                                    continue;
+                                }
+                            if (afs->fold)
+                                {
+                                    c = std::min(c, n - c);
+                                }
+                            total[afs->offsets[k] + c] += w;
+                        }
+                    return;
+                }
+            const double *s = node_summaries.data() + u * output_dim;
+            for (std::size_t i = 0; i < output_dim; ++i)
+                {
+                    total[i] += w * s[i];
+                }
+        }
+
+        void
+        update_node_summary(fwdpp::ts::table_index_t u)
+        {
+            evaluate(counts.data() + u * nsets, node_summaries.data() + u * output_dim);
+        }
+
+        void
+        update_path(const fwdpp::ts::edge &e, double sign)
+        // Adds sign times the counts of e.child to e.parent
+        // and its ancestors.
+        {
+            const double *c = counts.data() + e.child * nsets;
+            auto u = e.parent;
+            while (u != fwdpp::ts::NULL_INDEX)
+                {
+                    if (track_branches)
+                        {
+                            adjust_total(u, -1.0);
+                        }
+                    double *x = counts.data() + u * nsets;
+                    for (std::size_t k = 0; k < nsets; ++k)
+                        {
+                            x[k] += sign * c[k];
+                        }
+                    if (track_branches)
+                        {
+                            if (afs == nullptr)
+                                {
+                                    update_node_summary(u);
+                                }
+                            adjust_total(u, 1.0);
+                        }
+                    u = parents[u];
+                }
+        }
+
+      public:
+        std::vector<fwdpp::ts::table_index_t> parents;
+        std::vector<double> counts;
+        // For branch mode, the statistic summed over
+        // all branches of the current tree.
+        std::vector<double> total;
+
+        incremental_statistic(const fwdpp::ts::std_table_collection &t,
+                              const sample_set_list &sample_sets,
+                              const std::vector<double> &sizes_, std::size_t dim,
+                              const fwdpy11_core::tree_statistic_summary &f,
+                              bool polarised_, bool branches, const afs_bins *bins)
+            : tables(t), nsets(sample_sets.size()), output_dim(dim), sizes(sizes_),
+              summary(f), polarised(polarised_), track_branches(branches), afs(bins),
+              complement(nsets), scratch(dim), node_summaries{},
+              parents(t.nodes.size(), fwdpp::ts::NULL_INDEX),
+              counts(t.nodes.size() * nsets, 0.0), total(dim, 0.0)
+        {
+            for (std::size_t k = 0; k < nsets; ++k)
+                {
+                    for (auto u : sample_sets[k])
+                        {
+                            counts[u * nsets + k] += 1.0;
+                        }
+                }
+            if (track_branches && afs == nullptr)
+                {
+                    node_summaries.resize(t.nodes.size() * output_dim);
+                    for (std::size_t u = 0; u < t.nodes.size(); ++u)
+                        {
+                            update_node_summary(static_cast<fwdpp::ts::table_index_t>(u));
+                        }
+                }
+        }
+
+        void
+        evaluate(const double *x, double *output)
+        // output = summary(x), plus summary(sizes - x) if not polarised.
+        {
+            std::fill(output, output + output_dim, 0.0);
+            summary(x, output);
+            if (!polarised)
+                {
+                    for (std::size_t k = 0; k < nsets; ++k)
+                        {
+                            complement[k] = sizes[k] - x[k];
+                        }
+                    std::fill(begin(scratch), end(scratch), 0.0);
+                    summary(complement.data(), scratch.data());
+                    for (std::size_t i = 0; i < output_dim; ++i)
+                        {
+                            output[i] += scratch[i];
+                        }
+                }
+        }
+
+        const double *
+        node_counts(fwdpp::ts::table_index_t u) const
+        {
+            return counts.data() + u * nsets;
+        }
+
+        void
+        insert_edge(const fwdpp::ts::edge &e)
+        {
+            parents[e.child] = e.parent;
+            if (track_branches)
+                {
+                    adjust_total(e.child, 1.0);
+                }
+            update_path(e, 1.0);
+        }
+
+        void
+        remove_edge(const fwdpp::ts::edge &e)
+        {
+            update_path(e, -1.0);
+            if (track_branches)
+                {
+                    adjust_total(e.child, -1.0);
+                }
+            parents[e.child] = fwdpp::ts::NULL_INDEX;
+        }
+    };
+
+    template <typename F>
+    void
+    visit_trees(const fwdpp::ts::std_table_collection &tables, double stop,
+                incremental_statistic &state, const F &f)
+    // Updates state for each tree from left to right and calls
+    // f(left, right) for each tree with left < stop.
+    {
+        const auto &edges = tables.edges;
+        for (const auto &e : edges)
+            {
+                if (e.parent < 0 || static_cast<std::size_t>(e.parent) >= tables.nodes.size()
+                    || e.child < 0
+                    || static_cast<std::size_t>(e.child) >= tables.nodes.size())
+                    {
+                        throw std::invalid_argument("edge refers to an invalid node");
+                    }
+            }
+        std::vector<std::size_t> insertion, removal;
+        edge_orders(tables, insertion, removal);
+
+        std::size_t j = 0, k = 0;
+        double left = 0.0;
+        while (left < stop)
+            {
+                while (k < removal.size() && edges[removal[k]].right == left)
+                    {
+                        state.remove_edge(edges[removal[k++]]);
+                    }
+                while (j < insertion.size() && edges[insertion[j]].left == left)
+                    {
+                        state.insert_edge(edges[insertion[j++]]);
+                    }
+                double right = tables.genome_length();
+                if (j < insertion.size())
+                    {
+                        right = std::min(right, edges[insertion[j]].left);
+                    }
+                if (k < removal.size())
+                    {
+                        right = std::min(right, edges[removal[k]].right);
+                    }
+                if (right == left)
+                    {
+                        throw std::runtime_error("edge table does not advance");
+                    }
+                f(left, right);
+                left = right;
+            }
+    }
+
+    // Adds value * length of the overlap of [left, right)
+    // with each window to that window's output.
+    void
+    add_to_windows(const std::vector<double> &windows, double left, double right,
+                   const std::vector<double> &value, std::vector<double> &rv)
+    {
+        const auto dim = value.size();
+        auto w = static_cast<std::size_t>(
+            std::distance(begin(windows),
+                          std::upper_bound(begin(windows), end(windows), left)));
+        w = (w == 0) ? 0 : w - 1;
+        for (; w + 1 < windows.size() && windows[w] < right; ++w)
+            {
+                const double overlap
+                    = std::min(right, windows[w + 1]) - std::max(left, windows[w]);
+                if (overlap > 0.0)
+                    {
+                        for (std::size_t i = 0; i < dim; ++i)
+                            {
+                                rv[w * dim + i] += overlap * value[i];
+                            }
+                    }
+            }
+    }
+
+    fwdpp::ts::std_table_collection::mutation_table::const_iterator
+    add_sites(const fwdpp::ts::std_table_collection &tables,
+              fwdpp::ts::std_table_collection::mutation_table::const_iterator m,
+              double right, const std::vector<double> &windows,
+              const fwdpy11_core::tree_statistic_options &options,
+              incremental_statistic &state, std::size_t output_dim,
+              std::vector<double> &site_value, std::vector<double> &rv)
+    // Adds the summary of each mutation at a position < right
+    // to the window containing it, and returns the first mutation
+    // not processed.
+    {
+        const auto &sites = tables.sites;
+        for (; m < end(tables.mutations) && sites[m->site].position < right; ++m)
+            {
+                const double pos = sites[m->site].position;
+                if (pos >= windows.back())
+                    {
+                        break;
+                    }
+                if ((m->neutral && !options.include_neutral)
+                    || (!m->neutral && !options.include_selected))
+                    {
+                        continue;
+                    }
+                const auto w = static_cast<std::size_t>(std::distance(
+                                   begin(windows),
+                                   std::upper_bound(begin(windows), end(windows), pos)))
+                               - 1;
+                state.evaluate(state.node_counts(m->node), site_value.data());
+                for (std::size_t i = 0; i < output_dim; ++i)
+                    {
+                        rv[w * output_dim + i] += site_value[i];
+                    }
+            }
+        return m;
+    }
+
+    void
+    check_sizes_for_pairs(const std::vector<std::vector<fwdpp::ts::table_index_t>> &s)
+    {
+        for (auto &i : s)
+            {
+                if (i.size() < 2)
+                    {
+                        throw std::invalid_argument(
+                            "sample sets must contain at least two nodes");
+                    }
+            }
+    }
+
+    std::vector<double>
+    windowed_statistic(const fwdpp::ts::std_table_collection &tables,
+                       const sample_set_list &sample_sets,
+                       const std::vector<double> &windows, std::size_t output_dim,
+                       const fwdpy11_core::tree_statistic_summary &summary,
+                       const fwdpy11_core::tree_statistic_options &options,
+                       const afs_bins *afs)
+    // tree_statistic, where afs is non-null only for the
+    // site frequency spectrum.
+    {
+        if (output_dim == 0)
+            {
+                throw std::invalid_argument("output dimension must be > 0");
+            }
+        if (!summary)
+            {
+                throw std::invalid_argument("summary function is empty");
+            }
+        validate_windows(windows, tables.genome_length());
+        const auto sizes = sample_set_sizes(sample_sets, tables.nodes.size());
+        const bool branch_mode = options.mode == fwdpy11_core::statistic_mode::branch;
+        incremental_statistic state(tables, sample_sets, sizes, output_dim, summary,
+                                    options.polarised, branch_mode, afs);
+        const std::size_t nwindows = windows.size() - 1;
+        std::vector<double> rv(nwindows * output_dim, 0.0);
+        std::vector<double> site_value(output_dim);
+
+        const auto &sites = tables.sites;
+        auto m = std::lower_bound(
+            begin(tables.mutations), end(tables.mutations), windows.front(),
+            [&sites](const fwdpp::ts::mutation_record &mr, double v) {
+                return sites[mr.site].position < v;
+            });
+
+        visit_trees(tables, windows.back(), state, [&](double left, double right) {
+            if (right > windows.front())
+                {
+                    if (branch_mode)
+                        {
+                            add_to_windows(windows, left, right, state.total, rv);
+                        }
+                    else
+                        {
+                            m = add_sites(tables, m, right, windows, options, state,
+                                          output_dim, site_value, rv);
+                        }
+                }
+        });
+        if (options.span_normalise)
+            {
+                for (std::size_t w = 0; w < nwindows; ++w)
+                    {
+                        const double span = windows[w + 1] - windows[w];
+                        for (std::size_t i = 0; i < output_dim; ++i)
+                            {
+                                rv[w * output_dim + i] /= span;
+                            }
+                    }
+            }
+        return rv;
+    }
+}
+
+namespace fwdpy11_core
+{
+    std::vector<double>
+    tree_statistic(const fwdpp::ts::std_table_collection &tables,
+                   const sample_set_list &sample_sets, const std::vector<double> &windows,
+                   std::size_t output_dim, const tree_statistic_summary &summary,
+                   const tree_statistic_options &options)
+    {
+        return windowed_statistic(tables, sample_sets, windows, output_dim, summary,
+                                  options, nullptr);
+    }
+
+    std::vector<double>
+    diversity(const fwdpp::ts::std_table_collection &tables,
+              const sample_set_list &sample_sets, const std::vector<double> &windows,
+              const tree_statistic_options &options)
+    {
+        check_sizes_for_pairs(sample_sets);
+        std::vector<double> n;
+        for (auto &s : sample_sets)
+            {
+                n.push_back(static_cast<double>(s.size()));
+            }
+        auto o = options;
+        o.polarised = true;
+        return tree_statistic(
+            tables, sample_sets, windows, sample_sets.size(),
+            [&n](const double *x, double *output) {
+                for (std::size_t k = 0; k < n.size(); ++k)
+                    {
+                        output[k] = 2.0 * x[k] * (n[k] - x[k]) / (n[k] * (n[k] - 1.0));
+                    }
+            },
+            o);
+    }
+
+    std::vector<double>
+    divergence(const fwdpp::ts::std_table_collection &tables,
+               const sample_set_list &sample_sets,
+               const std::vector<std::pair<std::size_t, std::size_t>> &indexes,
+               const std::vector<double> &windows, const tree_statistic_options &options)
+    {
+        if (indexes.empty())
+            {
+                throw std::invalid_argument("empty list of sample set indexes");
+            }
+        std::vector<double> n;
+        for (auto &s : sample_sets)
+            {
+                n.push_back(static_cast<double>(s.size()));
+            }
+        for (auto &i : indexes)
+            {
+                if (i.first >= n.size() || i.second >= n.size())
+                    {
+                        throw std::invalid_argument("sample set index out of range");
+                    }
+            }
+        auto o = options;
+        o.polarised = true;
+        return tree_statistic(
+            tables, sample_sets, windows, indexes.size(),
+            [&n, &indexes](const double *x, double *output) {
+                for (std::size_t p = 0; p < indexes.size(); ++p)
+                    {
+                        const auto a = indexes[p].first, b = indexes[p].second;
+                        output[p] = (x[a] * (n[b] - x[b]) + x[b] * (n[a] - x[a]))
+                                    / (n[a] * n[b]);
+                    }
+            },
+            o);
+    }
+
+    std::vector<double>
+    segregating_sites(const fwdpp::ts::std_table_collection &tables,
+                      const sample_set_list &sample_sets,
+                      const std::vector<double> &windows,
+                      const tree_statistic_options &options)
+    {
+        std::vector<double> n;
+        for (auto &s : sample_sets)
+            {
+                n.push_back(static_cast<double>(s.size()));
+            }
+        auto o = options;
+        o.polarised = true;
+        return tree_statistic(
+            tables, sample_sets, windows, sample_sets.size(),
+            [&n](const double *x, double *output) {
+                for (std::size_t k = 0; k < n.size(); ++k)
+                    {
+                        output[k] = (x[k] > 0.0 && x[k] < n[k]) ? 1.0 : 0.0;
+                    }
+            },
+            o);
+    }
+
+    std::vector<double>
+    allele_frequency_spectrum(const fwdpp::ts::std_table_collection &tables,
+                              const sample_set_list &sample_sets,
+                              const std::vector<double> &windows,
+                              const tree_statistic_options &options)
+    {
+        std::vector<std::size_t> n, offsets;
+        std::size_t dim = 0;
+        for (auto &s : sample_sets)
+            {
+                n.push_back(s.size());
+                offsets.push_back(dim);
+                dim += s.size() + 1;
+            }
+        const bool fold = !options.polarised;
+        auto o = options;
+        o.polarised = true;
+        const afs_bins bins{offsets, fold};
+        return windowed_statistic(
+            tables, sample_sets, windows, dim,
+            [&n, &offsets, fold](const double *x, double *output) {
+                for (std::size_t k = 0; k < n.size(); ++k)
+                    {
+                        auto c = static_cast<std::size_t>(x[k]);
+                        if (c == 0 || c == n[k])
+                            {
+                                continue;
+                            }
+                        if (fold)
+                            {
+                                c = std::min(c, n[k] - c);
+                            }
+                        output[offsets[k] + c] += 1.0;
+                    }
+            },
+            o, &bins);
+    }
+
+    std::vector<std::uint32_t>
+    count_mutations_by_sample_set(const fwdpp::ts::std_table_collection &tables,
+                                  const std::vector<std::int32_t> &sample_set_of_node,
+                                  std::size_t nsets, std::size_t nmutations)
+    {
+        if (nsets == 0)
+            {
+                throw std::invalid_argument("the number of sample sets must be > 0");
+            }
+        if (sample_set_of_node.size() != tables.nodes.size())
+            {
+                throw std::invalid_argument(
+                    "there must be one sample set index per node");
+            }
+        sample_set_list sample_sets(nsets);
+        for (std::size_t u = 0; u < sample_set_of_node.size(); ++u)
+            {
+                const auto k = sample_set_of_node[u];
+                if (k < -1 || k >= static_cast<std::int32_t>(nsets))
+                    {
+                        throw std::invalid_argument("sample set index out of range");
+                    }
+                if (k >= 0)
+                    {
+                        sample_sets[k].push_back(static_cast<fwdpp::ts::table_index_t>(u));
+                    }
+            }
+        for (const auto &mr : tables.mutations)
+            {
+                if (mr.key >= nmutations)
+                    {
+                        throw std::invalid_argument("mutation key out of range");
+                    }
+            }
+
+        // Only the counts are needed, so the summary is never evaluated.
+        const std::vector<double> sizes(nsets, 0.0);
+        const tree_statistic_summary unused = [](const double *, double *) {};
+        incremental_statistic state(tables, sample_sets, sizes, 1, unused, true,
+                                    false, nullptr);
+        std::vector<std::uint32_t> rv(nmutations * nsets, 0);
+        const auto &sites = tables.sites;
+        auto m = begin(tables.mutations);
+        visit_trees(tables, tables.genome_length(), state,
+                    [&](double /*left*/, double right) {
+                        for (; m < end(tables.mutations)
+                               && sites[m->site].position < right;
+                             ++m)
+                            {
+                                const double *c = state.node_counts(m->node);
+                                auto *r = rv.data() + m->key * nsets;
+                                for (std::size_t k = 0; k < nsets; ++k)
+                                    {
+                                        r[k] += static_cast<std::uint32_t>(c[k]);
+                                    }
+                            }
+                    });
+        return rv;
+    }
+}
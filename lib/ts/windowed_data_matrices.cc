@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <fwdpp/ts/tree_visitor.hpp>
+#include <fwdpp/ts/detail/generate_data_matrix_details.hpp>
+#include <core/ts/windowed_data_matrices.hpp>
+#include "parallel_blocks.hpp"
+
+namespace
+{
+    using visitor_t = fwdpp::ts::tree_visitor<fwdpp::ts::std_table_collection>;
+
+    void
+    validate_intervals(const std::vector<std::pair<double, double>> &intervals)
+    {
+        if (intervals.empty())
+            {
+                throw std::invalid_argument("empty interval list");
+            }
+        for (auto &i : intervals)
+            {
+                if (!std::isfinite(i.first) || !std::isfinite(i.second))
+                    {
+                        throw std::invalid_argument(
+                            "invalid interval: all values must be finite");
+                    }
+                if (i.second < 0.0 || i.first < 0.0)
+                    {
+                        throw std::invalid_argument(
+                            "invalid interval: all positions must be >= 0.0");
+                    }
+                if (!(i.second > i.first))
+                    {
+                        throw std::invalid_argument("invalid interval: end <= beg");
+                    }
+            }
+        for (std::size_t i = 1; i < intervals.size(); ++i)
+            {
+                if (!(intervals[i].first > intervals[i - 1].first))
+                    {
+                        throw std::invalid_argument("invalid interval start positions");
+                    }
+            }
+    }
+
+    void
+    clear_matrix(fwdpp::data_matrix &dm)
+    {
+        dm.neutral_keys.clear();
+        dm.selected_keys.clear();
+        dm.neutral.data.clear();
+        dm.neutral.positions.clear();
+        dm.selected.data.clear();
+        dm.selected.positions.clear();
+    }
+
+    struct window_block
+    {
+        const fwdpp::ts::std_table_collection &tables;
+        const std::vector<fwdpp::ts::table_index_t> &samples;
+        const std::vector<std::pair<double, double>> &intervals;
+        const bool record_neutral, record_selected, include_fixations;
+        const fwdpy11_core::window_data_matrix_callback &callback;
+
+        void
+        operator()(std::size_t first, std::size_t last) const
+        {
+            using site_itr = fwdpp::ts::std_table_collection::site_table::const_iterator;
+            using mut_itr
+                = fwdpp::ts::std_table_collection::mutation_table::const_iterator;
+            const auto sbeg = begin(tables.sites), send = end(tables.sites);
+            const auto mbeg = begin(tables.mutations), mend = end(tables.mutations);
+
+            std::unique_ptr<visitor_t> current(
+                new visitor_t(tables, samples, fwdpp::ts::update_samples_list(true)));
+            bool more = current->operator()();
+            if (!more)
+                {
+                    throw std::invalid_argument("TableCollection contains no trees");
+                }
+            // Copy of the visitor at the tree containing
+            // the left edge of the next interval.
+            std::unique_ptr<visitor_t> saved(nullptr);
+            std::vector<std::int8_t> genotypes(samples.size(), 0);
+            fwdpp::data_matrix dm(samples.size());
+
+            for (std::size_t w = first; w < last; ++w)
+                {
+                    const double left = intervals[w].first, right = intervals[w].second;
+                    const bool has_next = w + 1 < last;
+                    const double next_left = has_next ? intervals[w + 1].first : 0.0;
+                    if (saved != nullptr)
+                        {
+                            current.swap(saved);
+                            saved.reset(nullptr);
+                            more = true;
+                        }
+                    while (more && current->tree().right <= left)
+                        {
+                            more = current->operator()();
+                        }
+                    clear_matrix(dm);
+                    site_itr s = std::lower_bound(
+                        sbeg, send, left, [](const fwdpp::ts::site &site, double v) {
+                            return site.position < v;
+                        });
+                    mut_itr m = mbeg;
+                    if (s < send)
+                        {
+                            m = std::lower_bound(
+                                mbeg, mend, s->position,
+                                [sbeg](const fwdpp::ts::mutation_record &mr, double p) {
+                                    return (sbeg + mr.site)->position < p;
+                                });
+                        }
+                    while (more && current->tree().left < right)
+                        {
+                            const auto &tree = current->tree();
+                            if (has_next && saved == nullptr && tree.left <= next_left
+                                && next_left < tree.right)
+                                {
+                                    saved.reset(new visitor_t(*current));
+                                }
+                            for (; s < send && s->position < tree.right
+                                   && s->position < right;
+                                 ++s)
+                                {
+                                    while (m < mend
+                                           && (sbeg + m->site)->position < s->position)
+                                        {
+                                            ++m;
+                                        }
+                                    auto mlast = m;
+                                    while (mlast < mend
+                                           && (sbeg + mlast->site)->position
+                                                  == s->position)
+                                        {
+                                            ++mlast;
+                                        }
+                                    fwdpp::ts::detail::process_site_range(
+                                        tree, s, std::make_pair(m, mlast),
+                                        record_neutral, record_selected,
+                                        !include_fixations, genotypes, dm);
+                                    m = mlast;
+                                }
+                            more = current->operator()();
+                        }
+                    callback(w, dm);
+                }
+        }
+    };
+}
+
+namespace fwdpy11_core
+{
+    void
+    windowed_data_matrices(const fwdpp::ts::std_table_collection &tables,
+                           const std::vector<fwdpp::ts::table_index_t> &samples,
+                           const std::vector<std::pair<double, double>> &intervals,
+                           bool record_neutral, bool record_selected,
+                           bool include_fixations, std::size_t num_threads,
+                           const window_data_matrix_callback &callback)
+    {
+        validate_intervals(intervals);
+        const window_block block{tables,         samples,         intervals,
+                                 record_neutral, record_selected, include_fixations,
+                                 callback};
+        internal::run_in_blocks(
+            intervals.size(), num_threads,
+            [&block](std::size_t, std::size_t first, std::size_t last) {
+                block(first, last);
+            });
+    }
+}
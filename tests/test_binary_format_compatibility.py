@@ -1,5 +1,11 @@
+import os
+import pickle
+import struct
+import tempfile
 import unittest
 
+import numpy as np
+
 import fwdpy11
 
 from utils import make_path
@@ -16,5 +22,86 @@ class TestOldBinaryFileFormats(unittest.TestCase):
             )
 
 
+class TestBinaryFormatVersion7(unittest.TestCase):
+    @classmethod
+    def setUpClass(self):
+        N = 100
+        params = fwdpy11.ModelParams(
+            nregions=[],
+            sregions=[fwdpy11.ExpS(0, 1, 1, -0.05)],
+            recregions=[fwdpy11.PoissonInterval(0, 1, 1e-2)],
+            rates=(0, 1e-2, None),
+            gvalue=fwdpy11.Multiplicative(2.0),
+            demography=fwdpy11.ForwardDemesGraph.tubes([N], burnin=1),
+            simlen=N,
+        )
+        self.pop = fwdpy11.DiploidPopulation(N, 1.0)
+        rng = fwdpy11.GSLrng(918)
+
+        def recorder(pop, sampler):
+            if pop.generation % 25 == 0:
+                sampler.assign(np.arange(5, dtype=np.uint32))
+
+        fwdpy11.evolvets(rng, self.pop, params, 10, recorder)
+        assert len(self.pop.ancient_sample_metadata) > 0
+        self.tmpdir = tempfile.TemporaryDirectory()
+
+    @classmethod
+    def tearDownClass(self):
+        self.tmpdir.cleanup()
+
+    def dump(self):
+        fname = os.path.join(self.tmpdir.name, "pop.bin")
+        self.pop.dump_to_file(fname)
+        with open(fname, "rb") as f:
+            return f.read()
+
+    def load(self, data):
+        fname = os.path.join(self.tmpdir.name, "modified.bin")
+        with open(fname, "wb") as f:
+            f.write(data)
+        return fwdpy11.DiploidPopulation.load_from_file(fname)
+
+    def test_header(self):
+        data = self.dump()
+        self.assertEqual(data[:4], b"fp11")
+        version, index_size = struct.unpack("=iI", data[4:12])
+        self.assertEqual(version, 7)
+        self.assertEqual(index_size, np.dtype(np.int32).itemsize)
+
+    def test_round_trip_via_file(self):
+        loaded = self.load(self.dump())
+        self.assertEqual(loaded, self.pop)
+        self.assertTrue(loaded.tables == self.pop.tables)
+        self.assertTrue(
+            np.array_equal(
+                np.array(loaded.ancient_sample_metadata)["nodes"],
+                np.array(self.pop.ancient_sample_metadata)["nodes"],
+            )
+        )
+
+    def test_round_trip_via_pickle(self):
+        loaded = pickle.loads(pickle.dumps(self.pop, -1))
+        self.assertEqual(loaded, self.pop)
+        self.assertTrue(loaded.tables == self.pop.tables)
+
+    def test_reading_version_6(self):
+        # Version 6 files are version 7 files without
+        # the size of the node ids and the number of
+        # folded fixations, which is zero here.
+        data = self.dump()
+        self.assertEqual(struct.unpack("=Q", data[-8:])[0], 0)
+        v6 = b"fp11" + struct.pack("=i", 6) + data[12:-8]
+        loaded = self.load(v6)
+        self.assertEqual(loaded, self.pop)
+        self.assertTrue(loaded.tables == self.pop.tables)
+
+    def test_node_id_size_mismatch(self):
+        data = self.dump()
+        wrong_size = data[:8] + struct.pack("=I", 8) + data[12:]
+        with self.assertRaises(RuntimeError):
+            self.load(wrong_size)
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,112 @@
+#
+# Copyright (C) 2026 Kevin Thornton <krthornt@uci.edu>
+#
+# This file is part of fwdpy11.
+#
+# fwdpy11 is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# fwdpy11 is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with fwdpy11.  If not, see <http://www.gnu.org/licenses/>.
+#
+
+import ctypes
+import gc
+
+import numpy as np
+import pytest
+
+import fwdpy11
+
+# NOTE: ctypes callbacks are Python functions.
+# They acquire the GIL themselves, which makes them
+# fine for testing even though real uses would pass
+# in compiled code.
+
+GVALUE_FUNCTION = ctypes.CFUNCTYPE(
+    None,
+    ctypes.POINTER(ctypes.c_uint32),
+    ctypes.c_size_t,
+    ctypes.POINTER(ctypes.c_uint32),
+    ctypes.c_size_t,
+    ctypes.POINTER(ctypes.c_double),
+    ctypes.POINTER(ctypes.c_double),
+    ctypes.POINTER(ctypes.c_double),
+    ctypes.c_size_t,
+    ctypes.c_void_p,
+)
+
+FITNESS_FUNCTION = ctypes.CFUNCTYPE(
+    ctypes.c_double,
+    ctypes.POINTER(ctypes.c_double),
+    ctypes.c_size_t,
+    ctypes.c_double,
+    ctypes.c_double,
+    ctypes.c_void_p,
+)
+
+
+def strict_additive(g1, n1, g2, n2, esizes, dominance, gvalues, ndim, user_data):
+    g = 0.0
+    for i in range(n1):
+        g += esizes[g1[i]]
+    for i in range(n2):
+        g += esizes[g2[i]]
+    gvalues[0] = g
+
+
+def gss(gvalues, ndim, g, e, user_data):
+    return np.exp(-((g + e) ** 2) / 2.0)
+
+
+def test_null_function_pointer():
+    with pytest.raises(ValueError):
+        fwdpy11.CFunctionGeneticValue(0)
+    with pytest.raises(ValueError):
+        fwdpy11.CFunctionGeneticValueToFitnessMap(0)
+
+
+def _make_gvalue():
+    # The callbacks are only referenced by the
+    # objects that are returned.
+    return fwdpy11.CFunctionGeneticValue(
+        GVALUE_FUNCTION(strict_additive),
+        gvalue_to_fitness=fwdpy11.CFunctionGeneticValueToFitnessMap(
+            FITNESS_FUNCTION(gss)
+        ),
+    )
+
+
+def test_run():
+    gvalue = _make_gvalue()
+    gc.collect()
+    assert isinstance(gvalue.function, GVALUE_FUNCTION)
+    assert isinstance(gvalue.gvalue_to_fitness.function, FITNESS_FUNCTION)
+    pop = fwdpy11.DiploidPopulation(100, 1.0)
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.GaussianS(0.0, 1.0, 1.0, 0.1)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 0.5)],
+        "rates": (0, 1e-2, None),
+        "gvalue": gvalue,
+        "demography": fwdpy11.ForwardDemesGraph.tubes(
+            pop.deme_sizes()[1], burnin=20, burnin_is_exact=True
+        ),
+        "simlen": 20,
+        "prune_selected": False,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    rng = fwdpy11.GSLrng(101)
+    fwdpy11.evolvets(rng, pop, params, 100)
+    if len(pop.tables.mutations) == 0:
+        pytest.fail("simulation ended with no mutations")
+    for m in pop.diploid_metadata:
+        assert m.g == pytest.approx(fwdpy11.strict_additive_effects(pop, m))
+        assert m.w == pytest.approx(np.exp(-(m.g**2) / 2.0))
@@ -133,5 +133,34 @@ def test_gaussian_stabilizing_selection_pleiotropy():
     assert gss == gss2
 
 
+def test_batched_fitness_and_noise_during_simulation():
+    VS = 2.0
+    gvalue = fwdpy11.Additive(
+        2.0,
+        fwdpy11.GaussianStabilizingSelection.single_trait(
+            [fwdpy11.Optimum(optimum=0.5, VS=VS, when=0)]
+        ),
+        fwdpy11.GaussianNoise(sd=0.1, mean=0.05),
+    )
+    pop = fwdpy11.DiploidPopulation(500, 1.0)
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.GaussianS(0, 1, 1, 0.25)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0, 5e-3, None),
+        "gvalue": gvalue,
+        "demography": fwdpy11.ForwardDemesGraph.tubes(
+            pop.deme_sizes()[1], burnin=10, burnin_is_exact=True
+        ),
+        "simlen": 10,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    rng = fwdpy11.GSLrng(54321)
+    fwdpy11.evolvets(rng, pop, params, 100)
+    md = np.array(pop.diploid_metadata, copy=False)
+    assert md["e"].var() > 0.0
+    assert np.allclose(md["w"], np.exp(-((md["g"] + md["e"] - 0.5) ** 2) / (2 * VS)))
+
+
 if __name__ == "__main__":
     unittest.main()
@@ -0,0 +1,73 @@
+import numpy as np
+import pytest
+
+import fwdpy11
+
+
+class RecordEveryone:
+    def __init__(self, when):
+        self.when = when
+
+    def __call__(self, pop, sampler):
+        if pop.generation in self.when:
+            sampler.assign(np.arange(pop.N, dtype=np.uint32))
+
+
+def simulate(gvalue, sregions, seed):
+    N = 200
+    L = 10.0
+    pdict = {
+        "sregions": sregions,
+        "recregions": [fwdpy11.PoissonInterval(0, L, 0.5)],
+        "rates": (0, 5e-2, None),
+        "demography": fwdpy11.ForwardDemesGraph.tubes([N], burnin=1),
+        "gvalue": gvalue,
+        "prune_selected": False,
+        "simlen": 200,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    pop = fwdpy11.DiploidPopulation(N, L)
+    rng = fwdpy11.GSLrng(seed)
+    fwdpy11.evolvets(rng, pop, params, 100, recorder=RecordEveryone([50, 150]))
+    return pop, params
+
+
+def gss():
+    return fwdpy11.GaussianStabilizingSelection.single_trait(
+        [fwdpy11.Optimum(optimum=0.0, VS=1.0, when=0)]
+    )
+
+
+TRAIT_SREGIONS = [fwdpy11.GaussianS(0, 10, 1, 0.1, h=0.25)]
+FITNESS_SREGIONS = [fwdpy11.ExpS(0, 10, 1, -0.05, h=0.5)]
+
+
+@pytest.mark.parametrize(
+    "gvalue,sregions",
+    [
+        (fwdpy11.Additive(2.0, gss()), TRAIT_SREGIONS),
+        (fwdpy11.Additive(2.0), FITNESS_SREGIONS),
+        (fwdpy11.Multiplicative(2.0, gss()), TRAIT_SREGIONS),
+        (fwdpy11.Multiplicative(2.0), FITNESS_SREGIONS),
+    ],
+)
+def test_genetic_values_from_nodes(gvalue, sregions):
+    pop, params = simulate(gvalue, sregions, 135)
+    for md in [pop.diploid_metadata, pop.ancient_sample_metadata]:
+        md = np.array(md, copy=False)
+        gv = pop.genetic_values_from_nodes(params.gvalue, md["nodes"])
+        assert np.allclose(gv, md["g"])
+
+
+def test_genetic_values_from_nodes_subset_of_keys():
+    pop, params = simulate(fwdpy11.Additive(2.0), FITNESS_SREGIONS, 42)
+    md = np.array(pop.diploid_metadata, copy=False)
+    gv = pop.genetic_values_from_nodes(params.gvalue, md["nodes"], keys=[])
+    assert np.allclose(gv, 1.0)
+
+
+def test_genetic_values_from_nodes_unsupported_gvalue():
+    pop, _ = simulate(fwdpy11.Additive(2.0), FITNESS_SREGIONS, 42)
+    md = np.array(pop.diploid_metadata, copy=False)
+    with pytest.raises(ValueError):
+        pop.genetic_values_from_nodes(fwdpy11.GBR(gss()), md["nodes"])
@@ -1,3 +1,5 @@
+import pickle
+
 import numpy as np
 import pytest
 
@@ -48,6 +50,15 @@ def multiplicative_fitness_without_pruning(
     return w
 
 
+def additive_fitness_with_baseline(diploid, haploid_genomes, mutations, baseline):
+    # Assumes scaling = 2 and h = 1
+    w = baseline
+    for i in [diploid.first, diploid.second]:
+        for m in haploid_genomes[i].smutations:
+            w += mutations[m].s
+    return max(0.0, 1.0 + w)
+
+
 def test_popgen_model_multiplicative_fitness_with_pruning_and_track_mutations():
     L = 1e6
     N = 1000
@@ -298,3 +309,172 @@ def test_popgen_model_multiplicative_fitness_without_pruning_and_track_mutations
                         found += 1
                         break
         assert found == nextant
+
+
+def test_popgen_model_additive_fitness_fold_selected_fixations():
+    L = 1e6
+    N = 1000
+    pdict = {
+        "sregions": [fwdpy11.ExpS(0, L, 1, mean=0.025)],
+        "recregions": [fwdpy11.PoissonInterval(0, L, 0.01)],
+        "rates": (0, 1e-3, None),
+        "demography": fwdpy11.ForwardDemesGraph.tubes([N], burnin=10),
+        "gvalue": fwdpy11.Additive(scaling=2.0),
+        "prune_selected": False,
+        "simlen": N,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    pop = fwdpy11.DiploidPopulation(N, L)
+    rng = fwdpy11.GSLrng(54321)
+
+    class Recorder:
+        def __call__(self, pop, _):
+            baseline = params.gvalue.fixation_baseline[0]
+            for i, d in enumerate(pop.diploids):
+                w = additive_fitness_with_baseline(
+                    d, pop.haploid_genomes, pop.mutations, baseline
+                )
+                assert np.isclose([w], [pop.diploid_metadata[i].w])
+
+    class Stop:
+        def __call__(self, pop, _):
+            return len(pop.fixations) > 1
+
+    assert params.gvalue.fixation_baseline == [0.0]
+    fwdpy11.evolvets(
+        rng,
+        pop,
+        params,
+        track_mutation_counts=True,
+        simplification_interval=100,
+        recorder=Recorder(),
+        stopping_criterion=Stop(),
+        fold_selected_fixations=True,
+    )
+    assert len(pop.fixations) > 1
+    baseline = params.gvalue.fixation_baseline[0]
+    assert np.isclose(baseline, sum([2.0 * f.s for f in pop.fixations]))
+    for i, d in enumerate(pop.diploids):
+        w = additive_fitness_with_baseline(
+            d, pop.haploid_genomes, pop.mutations, baseline
+        )
+        assert np.isclose([w], [pop.diploid_metadata[i].w])
+    for g in pop.haploid_genomes:
+        if g.n > 0:
+            for m in g.smutations:
+                assert pop.mcounts[m] < 2 * pop.N
+
+    unpickled = pickle.loads(pickle.dumps(params.gvalue))
+    assert unpickled.fixation_baseline == params.gvalue.fixation_baseline
+    assert unpickled._num_folded_fixations == pop.num_folded_fixations
+
+
+def test_fold_selected_fixations_two_replicates_one_params_object():
+    L = 1e6
+    N = 1000
+    pdict = {
+        "sregions": [fwdpy11.ExpS(0, L, 1, mean=0.025)],
+        "recregions": [fwdpy11.PoissonInterval(0, L, 0.01)],
+        "rates": (0, 1e-3, None),
+        "demography": fwdpy11.ForwardDemesGraph.tubes([N], burnin=10),
+        "gvalue": fwdpy11.Additive(scaling=2.0),
+        "prune_selected": False,
+        "simlen": N,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+
+    class Recorder:
+        def __call__(self, pop, _):
+            baseline = params.gvalue.fixation_baseline[0]
+            for i, d in enumerate(pop.diploids):
+                w = additive_fitness_with_baseline(
+                    d, pop.haploid_genomes, pop.mutations, baseline
+                )
+                assert np.isclose([w], [pop.diploid_metadata[i].w])
+
+    class Stop:
+        def __call__(self, pop, _):
+            return len(pop.fixations) > 1
+
+    pops = []
+    for seed in [54321, 98765]:
+        pop = fwdpy11.DiploidPopulation(N, L)
+        rng = fwdpy11.GSLrng(seed)
+        fwdpy11.evolvets(
+            rng,
+            pop,
+            params,
+            track_mutation_counts=True,
+            simplification_interval=100,
+            recorder=Recorder(),
+            stopping_criterion=Stop(),
+            fold_selected_fixations=True,
+        )
+        assert pop.num_folded_fixations == len(pop.fixations)
+        assert params.gvalue._num_folded_fixations == pop.num_folded_fixations
+        # The baseline only contains the fixations of this replicate
+        baseline = params.gvalue.fixation_baseline[0]
+        assert np.isclose(baseline, sum([2.0 * f.s for f in pop.fixations]))
+        pops.append(pop)
+
+    # Only the object holding the baseline of a
+    # population can be used to calculate its genetic values.
+    nodes = np.array(pops[1].diploid_metadata)["nodes"]
+    w = pops[1].genetic_values_from_nodes(params.gvalue, nodes)
+    assert np.allclose(w, np.array(pops[1].diploid_metadata)["g"])
+    with pytest.raises(ValueError):
+        pops[1].genetic_values_from_nodes(fwdpy11.Additive(scaling=2.0), nodes)
+
+
+@pytest.mark.parametrize(
+    "gvalue,expected",
+    [
+        (fwdpy11.Additive(2.0), [0.0]),
+        (fwdpy11.Additive(2.0, ndemes=2), [0.0, 0.0]),
+        (fwdpy11.Multiplicative(2.0), [1.0]),
+        (
+            fwdpy11.AdditivePleiotropy(
+                3,
+                0,
+                fwdpy11.GaussianStabilizingSelection.pleiotropy(
+                    [fwdpy11.PleiotropicOptima(np.zeros(3), 10.0, when=0)]
+                ),
+            ),
+            [0.0, 0.0, 0.0],
+        ),
+    ],
+)
+def test_fixation_baseline_pickling(gvalue, expected):
+    assert gvalue.fixation_baseline == expected
+    with pytest.raises(ValueError):
+        gvalue._set_fixation_baseline(expected + [0.0], 0)
+    modified = [i + 0.5 for i in expected]
+    gvalue._set_fixation_baseline(modified, 3)
+    unpickled = pickle.loads(pickle.dumps(gvalue))
+    assert unpickled == gvalue
+    assert unpickled.fixation_baseline == modified
+    assert unpickled._num_folded_fixations == 3
+
+
+def test_fold_selected_fixations_unsupported_type():
+    L = 1.0
+    N = 100
+    pdict = {
+        "sregions": [fwdpy11.ExpS(0, L, 1, mean=0.025)],
+        "recregions": [fwdpy11.PoissonInterval(0, L, 0.01)],
+        "rates": (0, 1e-3, None),
+        "demography": fwdpy11.ForwardDemesGraph.tubes([N], burnin=10),
+        "gvalue": fwdpy11.GBR(
+            fwdpy11.GaussianStabilizingSelection.single_trait(
+                [fwdpy11.Optimum(optimum=0.0, VS=1.0, when=0)]
+            )
+        ),
+        "prune_selected": False,
+        "simlen": 10,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    pop = fwdpy11.DiploidPopulation(N, L)
+    rng = fwdpy11.GSLrng(54321)
+    assert params.gvalue.fixation_baseline == []
+    with pytest.raises(ValueError):
+        fwdpy11.evolvets(rng, pop, params, 100, fold_selected_fixations=True)
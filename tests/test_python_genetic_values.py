@@ -177,6 +177,32 @@ class TestCustomPyGeneticValue(unittest.TestCase):
         self.assertTrue(md["e"].var() > 0.0)
 
 
+class TestCustomPyGeneticValueBatch(unittest.TestCase):
+    def test_run(self):
+        import pyadditivebatch
+        import pygss
+
+        gv = pyadditivebatch.PyAdditiveBatch(pygss.PyGSS(opt=0.0, VS=1.0))
+        pdict = build_single_trait_model(gv, 100)
+        pop = fwdpy11.DiploidPopulation(1000, 1.0)
+        pdict["demography"] = fwdpy11.ForwardDemesGraph.tubes(
+            pop.deme_sizes()[1], burnin=pdict["simlen"], burnin_is_exact=True
+        )
+        pdict["prune_selected"] = False
+        params = fwdpy11.ModelParams(**pdict)
+        rng = fwdpy11.GSLrng(42 * 666)
+
+        fwdpy11.evolvets(rng, pop, params, 100)
+        if len(pop.tables.mutations) == 0:
+            self.fail("simulation ended with no mutations")
+        md = np.array(pop.diploid_metadata, copy=False)
+        self.assertTrue(md["g"].var() > 0.0)
+        for i, m in enumerate(pop.diploid_metadata):
+            self.assertAlmostEqual(
+                md["g"][i], fwdpy11.strict_additive_effects(pop, m)
+            )
+
+
 class TestCustomPyGeneticValueOverloadGeneticValueToFitness(unittest.TestCase):
     def build_model(self, gvalue, simlen):
         pdict = {
@@ -0,0 +1,38 @@
+import numpy as np
+
+import fwdpy11
+
+
+def test_tables_agree_with_genomes_with_redundant_breakpoints():
+    # Crossovers at integer positions, including 0,
+    # produce duplicate and redundant breakpoints.
+    # If squashing them assigned a segment to the wrong
+    # parental node, the mutations in the tables would
+    # not match the genomes.
+    N = 50
+    L = 5
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, L, 1, -0.05)],
+        "recregions": [
+            fwdpy11.PoissonInterval(0, L, 3.0, discrete=True),
+            fwdpy11.BinomialPoint(0, 0.5),
+        ],
+        "rates": (0, 5e-3, None),
+        "gvalue": fwdpy11.Additive(2.0),
+        "demography": fwdpy11.ForwardDemesGraph.tubes([N], burnin=2),
+        "prune_selected": False,
+        "simlen": 2 * N,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    pop = fwdpy11.DiploidPopulation(N, L)
+    rng = fwdpy11.GSLrng(2024)
+    fwdpy11.evolvets(rng, pop, params, 10)
+    assert len(pop.tables.mutations) > 0
+
+    md = np.array(pop.diploid_metadata, copy=False)
+    gv = pop.genetic_values_from_nodes(params.gvalue, md["nodes"])
+    assert np.allclose(gv, md["g"])
+
+    edges = np.array(pop.tables.edges, copy=False)
+    assert np.all(edges["left"] < edges["right"])
@@ -354,6 +354,63 @@ class TestTreeSequencesNoAncientSamplesKeepFixations(unittest.TestCase):
                     nsites_visited += 1
             self.assertEqual(nsites_visited, nsites_in_interval)
 
+    def test_TreeIterator_arrays(self):
+        tv = fwdpy11.TreeIterator(self.pop.tables, [i for i in range(2 * self.pop.N)])
+        parents = tv.parent_array
+        leaf_counts = tv.leaf_counts_array
+        self.assertFalse(parents.flags.writeable)
+        with self.assertRaises(ValueError):
+            parents[0] = 0
+        for tree in tv:
+            for u in range(len(self.pop.tables.nodes)):
+                self.assertEqual(parents[u], tree.parent(u))
+                self.assertEqual(leaf_counts[u], tree.leaf_counts(u))
+                self.assertEqual(tree.left_child_array[u], tree.left_child(u))
+                self.assertEqual(tree.right_sib_array[u], tree.right_sib(u))
+
+    def test_TreeIterator_seek(self):
+        samples = [i for i in range(2 * self.pop.N)]
+        intervals = []
+        parents = []
+        sites = []
+        for tree in fwdpy11.TreeIterator(self.pop.tables, samples):
+            intervals.append((tree.left, tree.right))
+            parents.append(np.array(tree.parent_array))
+            sites.append([s.position for s in tree.sites()])
+
+        tv = fwdpy11.TreeIterator(self.pop.tables, samples)
+        for i in reversed(range(len(intervals))):
+            tv.seek(0.5 * (intervals[i][0] + intervals[i][1]))
+            self.assertEqual((tv.left, tv.right), intervals[i])
+            self.assertTrue(np.array_equal(tv.parent_array, parents[i]))
+            self.assertEqual([s.position for s in tv.sites()], sites[i])
+
+        # Seeking forwards, skipping some trees
+        for i in range(0, len(intervals), 3):
+            tv.seek(intervals[i][0])
+            self.assertEqual((tv.left, tv.right), intervals[i])
+            self.assertTrue(np.array_equal(tv.parent_array, parents[i]))
+            # Seeking within the current tree does nothing
+            tv.seek(0.5 * (intervals[i][0] + intervals[i][1]))
+            self.assertEqual((tv.left, tv.right), intervals[i])
+
+        # Iteration continues from the tree after the seek position
+        tv.seek(intervals[-2][0])
+        tree = next(tv)
+        self.assertEqual((tree.left, tree.right), intervals[-1])
+
+        # Starting at a tree gives the same trees
+        for i in range(0, len(intervals), max(1, len(intervals) // 10)):
+            tv = fwdpy11.TreeIterator(self.pop.tables, samples, begin=intervals[i][0])
+            for j, tree in enumerate(tv):
+                self.assertEqual((tree.left, tree.right), intervals[i + j])
+                self.assertTrue(np.array_equal(tree.parent_array, parents[i + j]))
+
+        with self.assertRaises(ValueError):
+            tv.seek(self.pop.tables.genome_length)
+        with self.assertRaises(ValueError):
+            tv.seek(-1.0)
+
     def test_leaf_counts_vs_mcounts(self):
         tv = fwdpy11.TreeIterator(self.pop.tables, [i for i in range(2 * self.pop.N)])
         mv = np.array(self.pop.tables.mutations, copy=False)
@@ -399,6 +456,19 @@ class TestTreeSequencesNoAncientSamplesKeepFixations(unittest.TestCase):
         msp_pos = np.sort(mspts.tables.sites.position)
         self.assertTrue(np.array_equal(fp11_pos, msp_pos))
 
+    def test_simplify_to_sample_num_threads(self):
+        samples = np.arange(0, 2 * self.pop.N, 50, dtype=np.int32)
+        tables, idmap = fwdpy11.simplify_tables(self.pop.tables, samples)
+        for num_threads in [2, 4]:
+            tables2, idmap2 = fwdpy11.simplify_tables(
+                self.pop.tables, samples, num_threads=num_threads
+            )
+            self.assertTrue(tables == tables2)
+            self.assertTrue(np.array_equal(idmap, idmap2))
+            self.assertEqual(
+                [m.key for m in tables.mutations], [m.key for m in tables2.mutations]
+            )
+
     def test_genotype_matrix(self):
         """
         Make data matrix objects from the tree sequences
@@ -502,6 +572,39 @@ class TestTreeSequencesNoAncientSamplesKeepFixations(unittest.TestCase):
         self.assertEqual(i, len(np.where(mc > 0)[0]))
         self.assertEqual(i, len(self.pop.tables.mutations))
 
+    def test_VariantIteratorChunks(self):
+        samples = [i for i in range(2 * self.pop.N)]
+        expected = [
+            (v.genotypes.copy(), v.position, v.records[0].key)
+            for v in fwdpy11.VariantIterator(self.pop.tables, samples)
+        ]
+        for chunk_size in [1, 7, len(expected) + 1]:
+            vi = fwdpy11.VariantIterator(self.pop.tables, samples)
+            rows = 0
+            for c in vi.chunks(chunk_size, mutations=self.pop.mutations):
+                self.assertTrue(len(c.keys) <= chunk_size)
+                for g, p, k, e in zip(c.genotypes, c.positions, c.keys, c.effect_sizes):
+                    self.assertTrue(np.array_equal(g, expected[rows][0]))
+                    self.assertEqual(p, expected[rows][1])
+                    self.assertEqual(k, expected[rows][2])
+                    self.assertEqual(e, self.pop.mutations[k].s)
+                    rows += 1
+            self.assertEqual(rows, len(expected))
+
+    def test_VariantIteratorChunkFilters(self):
+        samples = [i for i in range(2 * self.pop.N)]
+        vi = fwdpy11.VariantIterator(self.pop.tables, samples)
+        for c in vi.chunks(10, min_maf=0.1):
+            self.assertTrue(np.all(np.isnan(c.effect_sizes)))
+            p = c.genotypes.sum(axis=1) / len(samples)
+            self.assertTrue(np.all(np.minimum(p, 1.0 - p) >= 0.1))
+        vi = fwdpy11.VariantIterator(self.pop.tables, samples)
+        for c in vi.chunks(10, mutations=self.pop.mutations, labels=[1000]):
+            self.assertEqual(len(c.keys), 0)
+        vi = fwdpy11.VariantIterator(self.pop.tables, samples)
+        with self.assertRaises(ValueError):
+            next(vi.chunks(10, labels=[0]))
+
     def test_VariantIteratorBeginEnd(self):
         for i in np.arange(0, self.pop.tables.genome_length, 0.1):
             vi = fwdpy11.VariantIterator(
@@ -620,6 +723,33 @@ class TestTreeSequencesWithAncientSamplesKeepFixations(unittest.TestCase):
         )
         self.assertTrue(np.array_equal(mc, pmc))
 
+    def test_count_mutations_by_sample_set(self):
+        sample_set_of_node = np.full(len(self.pop.tables.nodes), -1, dtype=np.int32)
+        sample_set_of_node[self.pop.alive_nodes] = 0
+        node_lists = [self.pop.alive_nodes]
+        for i, (_, nodes, _) in enumerate(self.pop.sample_timepoints(False)):
+            sample_set_of_node[nodes] = i + 1
+            node_lists.append(nodes)
+        mc = fwdpy11.count_mutations_by_sample_set(self.pop, sample_set_of_node)
+        self.assertEqual(mc.shape, (len(self.pop.mutations), len(node_lists)))
+        for i, nodes in enumerate(node_lists):
+            self.assertTrue(
+                np.array_equal(mc[:, i], fwdpy11.count_mutations(self.pop, nodes))
+            )
+        self.assertTrue(
+            np.array_equal(
+                mc[:, 1:].sum(axis=1),
+                fwdpy11.count_mutations(self.pop, self.pop.preserved_nodes),
+            )
+        )
+
+        with self.assertRaises(ValueError):
+            fwdpy11.count_mutations_by_sample_set(self.pop, sample_set_of_node[1:])
+        with self.assertRaises(ValueError):
+            fwdpy11.count_mutations_by_sample_set(
+                self.pop, sample_set_of_node, nsets=1
+            )
+
     def test_ancient_sample_times(self):
         times = []
         for t, _, _ in self.pop.sample_timepoints(False):
@@ -1286,6 +1416,68 @@ class TestDataMatrixIterator(unittest.TestCase):
             self.assertTrue(np.array_equal(dm.selected_positions, pos_slice))
             self.assertTrue(np.array_equal(dm.selected, selected_slice))
 
+    def test_data_matrices_from_tables(self):
+        slices = [
+            (0.1, 0.2),
+            (0.15, 0.19),
+            (0.21, 0.37),
+            (0.38, 0.5337),
+            (0.39, 0.432),
+            (0.5, 0.55),
+            (0.9, 1.0),
+        ]
+        for num_threads in [1, 3, 10]:
+            matrices = fwdpy11.data_matrices_from_tables(
+                self.pop.tables, self.all_samples, slices, num_threads=num_threads
+            )
+            self.assertEqual(len(matrices), len(slices))
+            for r, dm in zip(slices, matrices):
+                rows = np.where((self.spos >= r[0]) & (self.spos < r[1]))[0]
+                self.assertTrue(
+                    np.array_equal(np.array(dm.selected.positions), self.spos[rows])
+                )
+                self.assertTrue(np.array_equal(np.array(dm.selected), self.selected[rows,]))
+                rows = np.where((self.npos >= r[0]) & (self.npos < r[1]))[0]
+                self.assertTrue(np.array_equal(np.array(dm.neutral), self.neutral[rows,]))
+
+    def test_packed_data_matrix(self):
+        haplotypes = self.selected
+        dosages = haplotypes[:, 0::2] + haplotypes[:, 1::2]
+        for packing, expected in zip(["haplotype", "dosage"], [haplotypes, dosages]):
+            pdm = fwdpy11.data_matrix_from_tables(
+                self.pop.tables, self.all_samples, packing=packing
+            )
+            m = pdm.selected
+            self.assertEqual(m.packing, packing)
+            self.assertEqual(m.ncol, expected.shape[1])
+            self.assertEqual(m.data.dtype, np.uint64)
+            self.assertEqual(m.data.shape[0], expected.shape[0])
+            self.assertTrue(np.array_equal(m.positions, self.spos))
+            self.assertTrue(np.array_equal(m.unpack(), expected))
+            self.assertTrue(np.array_equal(m.allele_counts(), haplotypes.sum(axis=1)))
+            het = (haplotypes[:, 0::2] != haplotypes[:, 1::2]).sum(axis=0)
+            self.assertTrue(np.array_equal(m.heterozygous_sites(), het))
+            sub = fwdpy11.data_matrix_from_tables(
+                self.pop.tables, self.all_samples[:20], packing=packing
+            ).selected
+            g = sub.unpack().astype(np.int32)
+            diffs = np.abs(g[:, :, None] - g[:, None, :]).sum(axis=0)
+            self.assertTrue(np.array_equal(sub.pairwise_differences(), diffs))
+
+    def test_packed_windows(self):
+        slices = [(0.1, 0.2), (0.15, 0.19), (0.5, 0.55)]
+        dmi = fwdpy11.DataMatrixIterator(
+            self.pop.tables, self.all_samples, slices, True, True
+        )
+        matrices = fwdpy11.data_matrices_from_tables(
+            self.pop.tables, self.all_samples, slices, packing="dosage", num_threads=2
+        )
+        for dm, pdm in zip(dmi, matrices):
+            expected = dm.selected[:, 0::2] + dm.selected[:, 1::2]
+            self.assertTrue(np.array_equal(dm.packed("dosage").selected.unpack(), expected))
+            self.assertTrue(np.array_equal(pdm.selected.unpack(), expected))
+            self.assertTrue(np.array_equal(pdm.selected.keys, dm.selected_keys))
+
 
 class TestTreeSequenceResettingDuringTimeSeriesAnalysis(unittest.TestCase):
     @classmethod
@@ -0,0 +1,334 @@
+import numpy as np
+import pytest
+
+import fwdpy11
+import fwdpy11.statistics
+
+
+@pytest.fixture(scope="module")
+def pop():
+    N = 100
+    L = 10.0
+    pdict = {
+        "sregions": [fwdpy11.ExpS(0, L, 1, -0.01)],
+        "recregions": [fwdpy11.PoissonInterval(0, L, 2.0)],
+        "rates": (0, 1e-2, None),
+        "demography": fwdpy11.ForwardDemesGraph.tubes([N], burnin=5),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "simlen": 5 * N,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    pop = fwdpy11.DiploidPopulation(N, L)
+    rng = fwdpy11.GSLrng(54321)
+    fwdpy11.evolvets(rng, pop, params, 100)
+    fwdpy11.infinite_sites(rng, pop, 0.5)
+    return pop
+
+
+@pytest.fixture(scope="module")
+def sample_sets(pop):
+    nodes = pop.alive_nodes
+    return [nodes[:50], nodes[50:120], nodes[120:]]
+
+
+@pytest.mark.parametrize("mode", ["site", "branch"])
+def test_against_tskit(pop, sample_sets, mode):
+    ts = pop.dump_tables_to_tskit()
+    windows = [0.0, 1.5, 2.0, 7.25, pop.tables.genome_length]
+    sets = [np.array(s, dtype=np.int32) for s in sample_sets]
+
+    pi = fwdpy11.statistics.diversity(
+        pop.tables, sample_sets, windows=windows, mode=mode
+    )
+    expected = ts.diversity(sets, windows=windows, mode=mode)
+    assert np.allclose(pi, expected)
+
+    d = fwdpy11.statistics.divergence(
+        pop.tables, sample_sets, windows=windows, mode=mode
+    )
+    expected = ts.divergence(sets, indexes=[(0, 1), (0, 2), (1, 2)], windows=windows, mode=mode)
+    assert np.allclose(d, expected)
+
+    S = fwdpy11.statistics.segregating_sites(pop.tables, sample_sets, mode=mode)
+    assert np.allclose(S, ts.segregating_sites(sets, mode=mode))
+
+    D = fwdpy11.statistics.tajimas_d(pop.tables, sample_sets, mode=mode)
+    assert np.allclose(D, ts.Tajimas_D(sets, mode=mode))
+
+    F = fwdpy11.statistics.fst(pop.tables, sample_sets, [(0, 2)], mode=mode)
+    pi = ts.diversity([sets[0], sets[2]], mode=mode)
+    d = ts.divergence([sets[0], sets[2]], mode=mode)
+    assert np.allclose(F, 1.0 - pi.mean() / d)
+
+
+def test_afs(pop, sample_sets):
+    for polarised in [True, False]:
+        afs = fwdpy11.statistics.allele_frequency_spectrum(
+            pop.tables, sample_sets, polarised=polarised, span_normalise=False
+        )
+        for s, a in zip(sample_sets, afs):
+            dm = fwdpy11.data_matrix_from_tables(pop.tables, s, include_fixations=True)
+            counts = np.concatenate(
+                (np.array(dm.neutral).sum(axis=1), np.array(dm.selected).sum(axis=1))
+            )
+            n = len(s)
+            counts = counts[(counts > 0) & (counts < n)]
+            if not polarised:
+                counts = np.minimum(counts, n - counts)
+            expected = np.bincount(counts, minlength=n + 1)
+            assert np.array_equal(a, expected)
+
+
+def test_neutral_only(pop, sample_sets):
+    dm = fwdpy11.data_matrix_from_tables(
+        pop.tables, sample_sets[0], record_neutral=True, record_selected=False
+    )
+    counts = np.array(dm.neutral).sum(axis=1)
+    n = len(sample_sets[0])
+    expected = np.sum(2 * counts * (n - counts) / (n * (n - 1)))
+    pi = fwdpy11.statistics.diversity(
+        pop.tables,
+        sample_sets[:1],
+        span_normalise=False,
+        record_selected=False,
+    )
+    assert np.isclose(pi[0], expected)
+
+
+def test_invalid_windows(pop, sample_sets):
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.diversity(pop.tables, sample_sets, windows=[0.0, 0.0])
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.diversity(
+            pop.tables, sample_sets, windows=[0.0, 2 * pop.tables.genome_length]
+        )
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.diversity(pop.tables, sample_sets, mode="node")
+
+
+def _naive_ld(genotypes):
+    n = genotypes.shape[1]
+    p = genotypes.sum(axis=1) / n
+    pab = genotypes.astype(np.float64) @ genotypes.T.astype(np.float64) / n
+    D = pab - np.outer(p, p)
+    with np.errstate(invalid="ignore", divide="ignore"):
+        r2 = D**2 / np.outer(p * (1 - p), p * (1 - p))
+    return D, r2
+
+
+def test_linkage_disequilibrium(pop, sample_sets):
+    samples = sample_sets[1]
+    dm = fwdpy11.data_matrix_from_tables(pop.tables, samples)
+    genotypes = np.concatenate((np.array(dm.neutral), np.array(dm.selected)))
+    positions = np.concatenate((dm.neutral.positions, dm.selected.positions))
+    order = np.argsort(positions, kind="stable")
+    D, r2 = _naive_ld(genotypes[order])
+
+    for num_threads in [1, 3]:
+        ld = fwdpy11.statistics.linkage_disequilibrium(dm, num_threads=num_threads)
+        assert np.array_equal(ld.positions, positions[order])
+        n = len(ld.positions)
+        assert len(ld.first) == n * (n - 1) // 2
+        assert np.allclose(ld.D, D[ld.first, ld.second])
+        assert np.allclose(ld.r2, r2[ld.first, ld.second], equal_nan=True)
+        assert np.all(np.abs(ld.D_prime[~np.isnan(ld.D_prime)]) <= 1.0 + 1e-12)
+        assert np.allclose(ld.matrix("D"), ld.matrix("D").T, equal_nan=True)
+
+    from_tables = fwdpy11.statistics.linkage_disequilibrium(
+        pop.tables, samples, max_sites_apart=3, num_threads=2
+    )
+    assert np.all(from_tables.second - from_tables.first <= 3)
+    assert np.allclose(from_tables.D, D[from_tables.first, from_tables.second])
+
+    banded = fwdpy11.statistics.linkage_disequilibrium(dm, max_distance=0.5)
+    assert np.all(
+        banded.positions[banded.second] - banded.positions[banded.first] <= 0.5
+    )
+    assert np.allclose(banded.D, D[banded.first, banded.second])
+
+    neutral = fwdpy11.statistics.linkage_disequilibrium(dm, record_selected=False)
+    assert np.array_equal(neutral.positions, dm.neutral.positions)
+
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.linkage_disequilibrium(dm, max_sites_apart=0)
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.linkage_disequilibrium(pop.tables)
+
+
+def _naive_ehh(genotypes, core, allele):
+    carriers = np.where(genotypes[core] == allele)[0]
+    n = len(carriers)
+    ehh = np.zeros(genotypes.shape[0])
+    for j in range(genotypes.shape[0]):
+        lo, hi = min(core, j), max(core, j)
+        haplotypes = [tuple(genotypes[lo : hi + 1, c]) for c in carriers]
+        _, counts = np.unique(haplotypes, axis=0, return_counts=True)
+        ehh[j] = np.sum(counts * (counts - 1)) / (n * (n - 1))
+    return ehh
+
+
+def test_haplotype_scan(pop, sample_sets):
+    samples = sample_sets[1]
+    dm = fwdpy11.data_matrix_from_tables(pop.tables, samples)
+    genotypes = np.concatenate((np.array(dm.neutral), np.array(dm.selected)))
+    positions = np.concatenate((dm.neutral.positions, dm.selected.positions))
+    order = np.argsort(positions, kind="stable")
+    genotypes, positions = genotypes[order], positions[order]
+
+    scan = fwdpy11.statistics.haplotype_scan(
+        dm, min_maf=0.0, include_edges=True, num_threads=2
+    )
+    assert np.array_equal(scan.positions, positions)
+    assert np.array_equal(scan.derived_counts, genotypes.sum(axis=1))
+    from_tables = fwdpy11.statistics.haplotype_scan(
+        pop.tables, samples, min_maf=0.0, include_edges=True
+    )
+    assert np.allclose(from_tables.ihs, scan.ihs, equal_nan=True)
+    assert np.allclose(from_tables.nsl, scan.nsl, equal_nan=True)
+
+    n = genotypes.shape[1]
+    for core in np.where(
+        (scan.derived_counts >= 2) & (scan.derived_counts <= n - 2)
+    )[0][:10]:
+        _, ancestral, derived = fwdpy11.statistics.ehh_decay(dm, core)
+        ihh = []
+        sl = []
+        for allele, ehh in ((0, ancestral), (1, derived)):
+            expected = _naive_ehh(genotypes, core, allele)
+            assert np.allclose(ehh, expected)
+            total = 0.0
+            for side, p in (
+                (ehh[core::-1], positions[core::-1]),
+                (ehh[core:], positions[core:]),
+            ):
+                below = np.where(side <= 0.05)[0]
+                stop = below[0] + 1 if len(below) > 0 else len(side)
+                e, x = side[:stop], np.abs(p[:stop] - positions[core])
+                total += np.sum(0.5 * (e[1:] + e[:-1]) * np.diff(x))
+            ihh.append(total)
+            sl.append(ehh.sum())
+        assert np.isclose(scan.ihh_ancestral[core], ihh[0])
+        assert np.isclose(scan.ihh_derived[core], ihh[1])
+        assert np.isclose(scan.ihs[core], np.log(ihh[0] / ihh[1]))
+        assert np.isclose(scan.nsl[core], np.log(sl[0] / sl[1]))
+
+    default = fwdpy11.statistics.haplotype_scan(dm)
+    maf = np.minimum(default.derived_counts, n - default.derived_counts) / n
+    assert np.all(np.isnan(default.ihs[maf < 0.05]))
+
+    z = fwdpy11.statistics.standardize_by_allele_count(scan.ihs, scan.derived_counts)
+    assert np.all(np.isnan(z[np.isnan(scan.ihs)]))
+    assert np.isclose(np.nanmean(z), 0.0)
+
+
+def test_association_scan(pop):
+    rng = np.random.default_rng(1234)
+    samples = pop.alive_nodes
+    n = len(samples) // 2
+    covariates = rng.normal(size=(n, 2))
+    phenotypes = np.array([md.g for md in pop.diploid_metadata]) + rng.normal(size=n)
+
+    dm = fwdpy11.data_matrix_from_tables(pop.tables, samples)
+    haplotypes = np.concatenate((np.array(dm.neutral), np.array(dm.selected)))
+    positions = np.concatenate((dm.neutral.positions, dm.selected.positions))
+    order = np.argsort(positions, kind="stable")
+    dosages = (haplotypes[:, 0::2] + haplotypes[:, 1::2])[order]
+
+    for num_threads, sites_per_chunk in [(1, 1000), (3, 7)]:
+        scan = fwdpy11.statistics.association_scan(
+            pop.tables,
+            samples,
+            phenotypes,
+            covariates=covariates,
+            sites_per_chunk=sites_per_chunk,
+            num_threads=num_threads,
+        )
+        assert np.array_equal(scan.positions, positions[order])
+        assert np.array_equal(scan.derived_counts, dosages.sum(axis=1))
+        for i in range(0, len(scan.positions), 11):
+            X = np.column_stack((np.ones(n), covariates, dosages[i]))
+            beta, rss, _, _ = np.linalg.lstsq(X, phenotypes, rcond=None)
+            df = n - X.shape[1]
+            se = np.sqrt(rss[0] / df * np.linalg.inv(X.T @ X)[-1, -1])
+            assert np.isclose(scan.beta[i], beta[-1])
+            assert np.isclose(scan.se[i], se)
+            assert 0.0 <= scan.pvalue[i] <= 1.0
+
+    # Without covariates, the test is a simple regression
+    scan = fwdpy11.statistics.association_scan(pop.tables, samples, phenotypes)
+    i = np.argmax(scan.derived_counts)
+    slope = np.polyfit(dosages[i], phenotypes, 1)[0]
+    assert np.isclose(scan.beta[i], slope)
+
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.association_scan(pop.tables, samples, phenotypes[1:])
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.association_scan(pop.tables, samples[1:], phenotypes)
+
+
+def _naive_ibd(tables, pairs):
+    samples = sorted({u for p in pairs for u in p})
+    segments = {p: [] for p in pairs}
+    for tree in fwdpy11.TreeIterator(tables, samples):
+        parent = np.array(tree.parent_array)
+        for a, b in pairs:
+            ancestors = set()
+            u = a
+            while u != -1:
+                ancestors.add(u)
+                u = parent[u]
+            u = b
+            while u != -1 and u not in ancestors:
+                u = parent[u]
+            if u == -1:
+                continue
+            s = segments[(a, b)]
+            if len(s) > 0 and s[-1][2] == u and s[-1][1] == tree.left:
+                s[-1][1] = tree.right
+            else:
+                s.append([tree.left, tree.right, u])
+    return {(a, b, *s) for (a, b), v in segments.items() for s in v}
+
+
+def test_ibd_segments(pop):
+    samples = sorted(pop.alive_nodes[:8])
+    pairs = [(a, b) for i, a in enumerate(samples) for b in samples[i + 1 :]]
+    expected = _naive_ibd(pop.tables, pairs)
+
+    ibd = fwdpy11.statistics.ibd_segments(pop.tables, samples)
+    found = set(
+        zip(
+            ibd.first.tolist(),
+            ibd.second.tolist(),
+            ibd.left.tolist(),
+            ibd.right.tolist(),
+            ibd.node.tolist(),
+        )
+    )
+    assert found == expected
+    assert np.array_equal(ibd.time, np.array(pop.tables.nodes)["time"][ibd.node])
+
+    min_length = np.median(ibd.length)
+    chosen = pairs[::3]
+    subset = fwdpy11.statistics.ibd_segments(
+        pop.tables, pairs=[(b, a) for a, b in chosen], min_length=min_length
+    )
+    found = set(
+        zip(
+            subset.first.tolist(),
+            subset.second.tolist(),
+            subset.left.tolist(),
+            subset.right.tolist(),
+            subset.node.tolist(),
+        )
+    )
+    assert found == {
+        s for s in expected if (s[0], s[1]) in chosen and s[3] - s[2] >= min_length
+    }
+
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.ibd_segments(pop.tables)
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.ibd_segments(pop.tables, samples, pairs=chosen)
+    with pytest.raises(ValueError):
+        fwdpy11.statistics.ibd_segments(pop.tables, samples, min_length=-1.0)
@@ -1,5 +1,6 @@
 import demes
 import fwdpy11
+import numpy as np
 import pytest
 
 
@@ -49,3 +50,44 @@ def test_issue_792(model_triggering_issue_792):
     fwdpy11.evolvets(rng, pop, params, 10)
 
     _ = pop.dump_tables_to_tskit()
+
+
+def test_node_ids_are_exported_as_int32():
+    pop = fwdpy11.DiploidPopulation(50, 1)
+    pdict = {
+        "nregions": [],
+        "sregions": [fwdpy11.ExpS(0, 1, 1, -0.05)],
+        "recregions": [fwdpy11.PoissonInterval(0, 1, 1e-2)],
+        "rates": (0, 1e-2, None),
+        "gvalue": fwdpy11.Multiplicative(2.0),
+        "demography": fwdpy11.ForwardDemesGraph.tubes(pop.deme_sizes()[1], burnin=1),
+        "simlen": 50,
+    }
+    params = fwdpy11.ModelParams(**pdict)
+    rng = fwdpy11.GSLrng(101)
+
+    def preserver(pop, sampler):
+        if pop.generation == 25:
+            sampler.assign(np.arange(5, dtype=np.uint32))
+
+    fwdpy11.evolvets(rng, pop, params, 100, recorder=preserver)
+    ts = pop.dump_tables_to_tskit()
+    mutations = np.array(pop.tables.mutations, copy=False)
+    assert len(mutations) > 0
+    assert np.array_equal(ts.tables.mutations.node, mutations["node"])
+    md = np.concatenate(
+        (
+            np.array(pop.diploid_metadata, copy=False)["nodes"],
+            np.array(pop.ancient_sample_metadata, copy=False)["nodes"],
+        )
+    )
+    for i, nodes in zip(ts.individuals(), md):
+        assert i.metadata["nodes"] == nodes.tolist()
+
+
+def test_too_large_node_ids_are_not_exported():
+    from fwdpy11.tskit_tools._dump_tables_to_tskit import _to_tskit_ids
+
+    ids = np.array([0, np.iinfo(np.int32).max + 1], dtype=np.int64)
+    with pytest.raises(ValueError):
+        _to_tskit_ids(ids)